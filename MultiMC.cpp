@@ -490,6 +490,10 @@ void MultiMC::initGlobalSettings(bool test_mode)
 	m_settings->registerSetting("RaiseConsole", true);
 	m_settings->registerSetting("AutoCloseConsole", true);
 	m_settings->registerSetting("LogPrePostOutput", true);
+	m_settings->registerSetting("ConsoleMaxLines", 100000);
+	m_settings->registerSetting("LogFilterMinLevel", QString("Debug"));
+	m_settings->registerSetting("LogFilterInclude", QString());
+	m_settings->registerSetting("LogFilterExclude", QString("ignoring option PermSize"));
 
 	// Console Colors
 	//	m_settings->registerSetting("SysMessageColor", QColor(Qt::blue));
@@ -517,6 +521,8 @@ void MultiMC::initGlobalSettings(bool test_mode)
 	m_settings->registerSetting("JavaPath", "");
 	m_settings->registerSetting("LastHostname", "");
 	m_settings->registerSetting("JavaDetectionHack", "");
+	// more folders with Java installations in them, separated by ';'
+	m_settings->registerSetting("JavaSearchDirs", "");
 	m_settings->registerSetting("JvmArgs", "");
 
 	// Custom Commands
@@ -37,21 +37,32 @@ private:
 		int number;
 		QString string;
 
-		inline bool operator!=(const Section &other) const
+		/// <0, 0 or >0, like QString::compare
+		inline int compare(const Section &other) const
 		{
-			return (numValid && other.numValid) ? (number != other.number) : (string != other.string);
-		}
-		inline bool operator<(const Section &other) const
-		{
-			return (numValid && other.numValid) ? (number < other.number) : (string < other.string);
-		}
-		inline bool operator>(const Section &other) const
-		{
-			return (numValid && other.numValid) ? (number > other.number) : (string > other.string);
+			if (numValid && other.numValid)
+			{
+				return (number > other.number) - (number < other.number);
+			}
+			return QString::compare(string, other.string);
 		}
 	};
 	QList<Section> m_sections;
 
+	/*
+	 * Versions made of up to PACKED_SECTIONS numeric sections that each fit in 16 bits
+	 * (nearly all of them) are also packed into one integer, most significant section first
+	 * and missing sections as 0. Two of those compare like the integers do.
+	 */
+	enum
+	{
+		PACKED_SECTIONS = 4
+	};
+	bool m_packed = false;
+	quint64 m_packedKey = 0;
+
+	/// <0, 0 or >0, depending on how this compares to the other version
+	int compare(const Version &other) const;
 	void parse();
 };
 
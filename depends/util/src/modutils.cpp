@@ -10,65 +10,52 @@ Util::Version::Version(const QString &str) : m_string(str)
 	parse();
 }
 
-bool Util::Version::operator<(const Version &other) const
+int Util::Version::compare(const Version &other) const
 {
+	if (m_packed && other.m_packed)
+	{
+		return (m_packedKey > other.m_packedKey) - (m_packedKey < other.m_packedKey);
+	}
+
+	// missing sections count as zero
+	static const Section zero("0", 0);
 	const int size = qMax(m_sections.size(), other.m_sections.size());
 	for (int i = 0; i < size; ++i)
 	{
-		const Section sec1 = (i >= m_sections.size()) ? Section("0", 0) : m_sections.at(i);
-		const Section sec2 =
-			(i >= other.m_sections.size()) ? Section("0", 0) : other.m_sections.at(i);
-		if (sec1 != sec2)
+		const Section &sec1 = (i >= m_sections.size()) ? zero : m_sections.at(i);
+		const Section &sec2 = (i >= other.m_sections.size()) ? zero : other.m_sections.at(i);
+		const int result = sec1.compare(sec2);
+		if (result != 0)
 		{
-			return sec1 < sec2;
+			return result;
 		}
 	}
+	return 0;
+}
 
-	return false;
+bool Util::Version::operator<(const Version &other) const
+{
+	return compare(other) < 0;
 }
 bool Util::Version::operator<=(const Util::Version &other) const
 {
-	return *this < other || *this == other;
+	return compare(other) <= 0;
 }
 bool Util::Version::operator>(const Version &other) const
 {
-	const int size = qMax(m_sections.size(), other.m_sections.size());
-	for (int i = 0; i < size; ++i)
-	{
-		const Section sec1 = (i >= m_sections.size()) ? Section("0", 0) : m_sections.at(i);
-		const Section sec2 =
-			(i >= other.m_sections.size()) ? Section("0", 0) : other.m_sections.at(i);
-		if (sec1 != sec2)
-		{
-			return sec1 > sec2;
-		}
-	}
-
-	return false;
+	return compare(other) > 0;
 }
 bool Util::Version::operator>=(const Version &other) const
 {
-	return *this > other || *this == other;
+	return compare(other) >= 0;
 }
 bool Util::Version::operator==(const Version &other) const
 {
-	const int size = qMax(m_sections.size(), other.m_sections.size());
-	for (int i = 0; i < size; ++i)
-	{
-		const Section sec1 = (i >= m_sections.size()) ? Section("0", 0) : m_sections.at(i);
-		const Section sec2 =
-			(i >= other.m_sections.size()) ? Section("0", 0) : other.m_sections.at(i);
-		if (sec1 != sec2)
-		{
-			return false;
-		}
-	}
-
-	return true;
+	return compare(other) == 0;
 }
 bool Util::Version::operator!=(const Version &other) const
 {
-	return !operator==(other);
+	return compare(other) != 0;
 }
 
 void Util::Version::parse()
@@ -90,6 +77,24 @@ void Util::Version::parse()
 			m_sections.append(Section(part));
 		}
 	}
+
+	m_packed = m_sections.size() <= PACKED_SECTIONS;
+	m_packedKey = 0;
+	for (int i = 0; i < PACKED_SECTIONS; ++i)
+	{
+		quint64 number = 0;
+		if (i < m_sections.size())
+		{
+			const Section &section = m_sections.at(i);
+			if (!section.numValid || section.number < 0 || section.number > 0xFFFF)
+			{
+				m_packed = false;
+				break;
+			}
+			number = section.number;
+		}
+		m_packedKey = (m_packedKey << 16) | number;
+	}
 }
 
 bool Util::versionIsInInterval(const QString &version, const QString &interval)
@@ -9,8 +9,11 @@
 #include <QDrag>
 #include <QMimeData>
 #include <QCache>
+#include <QHash>
 #include <QScrollBar>
 
+#include <algorithm>
+
 #include "VisualGroup.h"
 #include "logger/QsLog.h"
 
@@ -45,21 +48,149 @@ void GroupView::setModel(QAbstractItemModel *model)
 {
 	QAbstractItemView::setModel(model);
 	connect(model, &QAbstractItemModel::modelReset, this, &GroupView::modelReset);
+	connect(model, &QAbstractItemModel::layoutAboutToBeChanged, this,
+			&GroupView::invalidateLayout);
+	connect(model, &QAbstractItemModel::rowsAboutToBeMoved, this, &GroupView::invalidateLayout);
+	connect(model, &QAbstractItemModel::rowsRemoved, this, &GroupView::rowsRemoved);
 }
 
 void GroupView::dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
 							const QVector<int> &roles)
 {
+	for (int row = topLeft.row(); row <= bottomRight.row(); ++row)
+	{
+		if (row < m_sizeHints.size())
+		{
+			m_sizeHints[row] = QSize();
+		}
+		// only the group of the item has to flow again, unless the item moved to another group
+		VisualGroup *group = itemLayout(row).group;
+		const QModelIndex index = model()->index(row, 0);
+		if (group && group->text == index.data(GroupViewRoles::GroupRole).toString())
+		{
+			group->dirty = true;
+		}
+		else
+		{
+			m_regroup = true;
+		}
+	}
 	scheduleDelayedItemsLayout();
 }
 void GroupView::rowsInserted(const QModelIndex &parent, int start, int end)
 {
+	const int count = end - start + 1;
+	if (start <= m_sizeHints.size())
+	{
+		m_sizeHints.insert(start, count, QSize());
+	}
 	scheduleDelayedItemsLayout();
+	// without a layout to patch, sort everything into groups from scratch
+	if (m_regroup || m_itemLayout.size() != model()->rowCount() - count)
+	{
+		m_itemLayout.clear();
+		m_regroup = true;
+		return;
+	}
+
+	// the items after the new ones stay where they are in their groups, only their row changes
+	for (auto group : m_groups)
+	{
+		group->shiftRows(start, count);
+	}
+	m_itemLayout.insert(start, count, ItemLayout());
+
+	for (int row = start; row <= end; ++row)
+	{
+		const QModelIndex index = model()->index(row, 0);
+		const QString groupName = index.data(GroupViewRoles::GroupRole).toString();
+		VisualGroup *group = category(groupName);
+		if (!group)
+		{
+			group = new VisualGroup(groupName, this);
+			auto position = std::lower_bound(m_groups.begin(), m_groups.end(), groupName,
+											 [](VisualGroup *other, const QString &name)
+			{ return QString::localeAwareCompare(other->text, name) < 0; });
+			m_groups.insert(position, group);
+		}
+		auto position = std::lower_bound(group->m_items.begin(), group->m_items.end(), row,
+										 [](const QModelIndex &item, int row)
+		{ return item.row() < row; });
+		group->m_items.insert(position, index);
+		group->dirty = true;
+		m_itemLayout[row].group = group;
+	}
 }
 
 void GroupView::rowsAboutToBeRemoved(const QModelIndex &parent, int start, int end)
 {
+	if (start < m_sizeHints.size())
+	{
+		m_sizeHints.remove(start, qMin(end + 1, m_sizeHints.size()) - start);
+	}
 	scheduleDelayedItemsLayout();
+	if (m_regroup || m_itemLayout.size() != model()->rowCount())
+	{
+		m_itemLayout.clear();
+		m_regroup = true;
+		return;
+	}
+
+	// take the items out of their groups now, while their indexes are still valid
+	for (int row = start; row <= end; ++row)
+	{
+		VisualGroup *group = m_itemLayout[row].group;
+		if (!group)
+		{
+			m_itemLayout.clear();
+			m_regroup = true;
+			return;
+		}
+		group->m_items.removeOne(model()->index(row, 0));
+		group->dirty = true;
+		// regrouping is what gets rid of empty groups
+		if (group->m_items.isEmpty())
+		{
+			m_regroup = true;
+		}
+	}
+	m_itemLayout.remove(start, end - start + 1);
+}
+
+void GroupView::rowsRemoved(const QModelIndex &parent, int start, int end)
+{
+	if (m_regroup)
+	{
+		return;
+	}
+	// the items after the removed ones stay where they are in their groups
+	for (auto group : m_groups)
+	{
+		group->shiftRows(end + 1, start - end - 1);
+	}
+}
+
+void GroupView::invalidateLayout()
+{
+	m_sizeHints.clear();
+	m_itemLayout.clear();
+	m_regroup = true;
+	geometryCache.clear();
+}
+
+QSize GroupView::itemSizeHint(const QModelIndex &index) const
+{
+	const int row = index.row();
+	if (row >= m_sizeHints.size())
+	{
+		m_sizeHints.resize(model()->rowCount());
+	}
+	QSize &hint = m_sizeHints[row];
+	if (!hint.isValid())
+	{
+		hint = itemDelegate()->sizeHint(viewOptions(), index);
+	}
+	return hint;
 }
 
 class LocaleString : public QString
@@ -78,29 +209,57 @@ inline bool operator<(const LocaleString &lhs, const LocaleString &rhs)
 	return (QString::localeAwareCompare(lhs, rhs) < 0);
 }
 
-void GroupView::updateGeometries()
+void GroupView::regroup()
 {
-	geometryCache.clear();
-	int previousScroll = verticalScrollBar()->value();
+	QHash<QString, VisualGroup *> cats;
+	// keep the existing groups, they know if they are collapsed
+	for (auto group : m_groups)
+	{
+		group->m_items.clear();
+		cats.insert(group->text, group);
+	}
 
-	QMap<LocaleString, VisualGroup *> cats;
+	const int rowCount = model()->rowCount();
+	m_itemLayout = QVector<ItemLayout>(rowCount);
+	for (int i = 0; i < rowCount; ++i)
+	{
+		const QModelIndex index = model()->index(i, 0);
+		const QString groupName = index.data(GroupViewRoles::GroupRole).toString();
+		VisualGroup *&group = cats[groupName];
+		if (!group)
+		{
+			group = new VisualGroup(groupName, this);
+		}
+		group->m_items.append(index);
+	}
 
-	for (int i = 0; i < model()->rowCount(); ++i)
+	QMap<LocaleString, VisualGroup *> sorted;
+	for (auto group : cats)
 	{
-		const QString groupName =
-			model()->index(i, 0).data(GroupViewRoles::GroupRole).toString();
-		if (!cats.contains(groupName))
+		if (group->m_items.isEmpty())
 		{
-			VisualGroup *old = this->category(groupName);
-			if (old)
-			{
-				cats.insert(groupName, new VisualGroup(old));
-			}
-			else
+			if (m_pressedCategory == group)
 			{
-				cats.insert(groupName, new VisualGroup(groupName, this));
+				m_pressedCategory = nullptr;
 			}
+			delete group;
+			continue;
 		}
+		group->dirty = true;
+		sorted.insert(group->text, group);
+	}
+	m_groups = sorted.values();
+	m_regroup = false;
+}
+
+void GroupView::updateGeometries()
+{
+	geometryCache.clear();
+	int previousScroll = verticalScrollBar()->value();
+
+	if (m_regroup || m_itemLayout.size() != model()->rowCount())
+	{
+		regroup();
 	}
 
 	/*if (m_editedCategory)
@@ -108,12 +267,12 @@ void GroupView::updateGeometries()
 		m_editedCategory = cats[m_editedCategory->text];
 	}*/
 
-	qDeleteAll(m_groups);
-	m_groups = cats.values();
-
 	for (auto cat : m_groups)
 	{
-		cat->update();
+		if (cat->dirty)
+		{
+			cat->update();
+		}
 	}
 
 	if (m_groups.isEmpty())
@@ -154,6 +313,7 @@ void GroupView::updateGeometries()
 
 void GroupView::modelReset()
 {
+	invalidateLayout();
 	scheduleDelayedItemsLayout();
 	executeDelayedItemsLayout();
 }
@@ -173,6 +333,11 @@ bool GroupView::isIndexHidden(const QModelIndex &index) const
 
 VisualGroup *GroupView::category(const QModelIndex &index) const
 {
+	VisualGroup *group = itemLayout(index.row()).group;
+	if (group)
+	{
+		return group;
+	}
 	return category(index.data(GroupViewRoles::GroupRole).toString());
 }
 
@@ -481,6 +646,10 @@ void GroupView::resizeEvent(QResizeEvent *event)
 	{
 		m_currentCursorColumn = -1;
 		m_currentItemsPerRow = newItemsPerRow;
+		for (auto group : m_groups)
+		{
+			group->dirty = true;
+		}
 		updateGeometries();
 	}
 }
@@ -618,7 +787,7 @@ QRect GroupView::geometryRect(const QModelIndex &index) const
 	QRect out;
 	out.setTop(cat->verticalPosition() + cat->headerHeight() + 5 + cat->rowTopOf(index));
 	out.setLeft(m_spacing + x * (itemWidth() + m_spacing));
-	out.setSize(itemDelegate()->sizeHint(viewOptions(), index));
+	out.setSize(itemSizeHint(index));
 	geometryCache.insert(row, new QRect(out));
 	return out;
 }
@@ -56,8 +56,11 @@ slots:
 							 const QVector<int> &roles) override;
 	virtual void rowsInserted(const QModelIndex &parent, int start, int end) override;
 	virtual void rowsAboutToBeRemoved(const QModelIndex &parent, int start, int end) override;
+	void rowsRemoved(const QModelIndex &parent, int start, int end);
 	virtual void updateGeometries() override;
 	void modelReset();
+	/// forget everything that is kept per model row, the rows are about to move around
+	void invalidateLayout();
 
 protected:
 	virtual bool isIndexHidden(const QModelIndex &index) const override;
@@ -79,6 +82,19 @@ private:
 	friend struct VisualGroup;
 	QList<VisualGroup *> m_groups;
 
+	/// where an item ended up in the layout, kept for each model row
+	struct ItemLayout
+	{
+		VisualGroup *group = nullptr;
+		int row = 0;
+		int column = 0;
+	};
+	QVector<ItemLayout> m_itemLayout;
+	/// size hints of the items by model row, invalid until asked for or after a change
+	mutable QVector<QSize> m_sizeHints;
+	/// true if the items have to be sorted into the groups again
+	bool m_regroup = true;
+
 	// geometry
 	int m_leftMargin = 5;
 	int m_rightMargin = 5;
@@ -94,7 +110,7 @@ private:
 	QPoint m_pressedPosition;
 	QPersistentModelIndex m_pressedIndex;
 	bool m_pressedAlreadySelected;
-	VisualGroup *m_pressedCategory;
+	VisualGroup *m_pressedCategory = nullptr;
 	QItemSelectionModel::SelectionFlag m_ctrlDragSelectionFlag;
 	QPoint m_lastDragPosition;
 
@@ -109,6 +125,21 @@ private:
 	int contentWidth() const;
 
 private: /* methods */
+	/// sort all the items into groups, in one pass over the model
+	void regroup();
+	QSize itemSizeHint(const QModelIndex &index) const;
+	ItemLayout itemLayout(int row) const
+	{
+		return (row >= 0 && row < m_itemLayout.size()) ? m_itemLayout[row] : ItemLayout();
+	}
+	void setItemLayout(int row, VisualGroup *group, int visualRow, int column)
+	{
+		ItemLayout &layout = m_itemLayout[row];
+		layout.group = group;
+		layout.row = visualRow;
+		layout.column = column;
+	}
+
 	int itemWidth() const;
 	int calculateItemsPerRow() const;
 	int verticalScrollToValue(const QModelIndex &index, const QRect &rect,
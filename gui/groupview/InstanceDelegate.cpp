@@ -26,6 +26,13 @@
 
 QCache<QString, QPixmap> ListViewDelegate::m_pixmapCache;
 
+// this many laid out texts are kept around, roughly one per instance
+#define TEXT_CACHE_SIZE 1000
+// icon pixmaps are kept up to this many KiB
+#define ICON_CACHE_SIZE (8 * 1024)
+// badges are drawn at this size
+#define BADGE_SIZE 24
+
 // Origin: Qt
 static void viewItemTextLayout(QTextLayout &textLayout, int lineWidth, qreal &height,
 							   qreal &widthUsed)
@@ -51,6 +58,8 @@ static void viewItemTextLayout(QTextLayout &textLayout, int lineWidth, qreal &he
 
 ListViewDelegate::ListViewDelegate(QObject *parent) : QStyledItemDelegate(parent)
 {
+	m_textCache.setMaxCost(TEXT_CACHE_SIZE);
+	m_iconCache.setMaxCost(ICON_CACHE_SIZE);
 }
 
 void drawSelectionRect(QPainter *painter, const QStyleOptionViewItemV4 &option,
@@ -144,7 +153,7 @@ void drawBadges(QPainter *painter, const QStyleOptionViewItemV4 &option, BaseIns
 	}
 	// end easter eggs
 
-	static const int itemSide = 24;
+	static const int itemSide = BADGE_SIZE;
 	static const int spacing = 1;
 	const int itemsPerRow = qMax(1, qFloor(double(option.rect.width() + spacing) / double(itemSide + spacing)));
 	const int rows = qCeil((double)pixmaps.size() / (double)itemsPerRow);
@@ -158,8 +167,7 @@ void drawBadges(QPainter *painter, const QStyleOptionViewItemV4 &option, BaseIns
 			{
 				return;
 			}
-			const QPixmap pixmap = ListViewDelegate::requestBadgePixmap(it.next()).scaled(
-				itemSide, itemSide, Qt::KeepAspectRatio, Qt::FastTransformation);
+			const QPixmap pixmap = ListViewDelegate::requestBadgePixmap(it.next());
 			painter->drawPixmap(option.rect.width() - x * itemSide + qMax(x - 1, 0) * spacing - itemSide,
 								y * itemSide + qMax(y - 1, 0) * spacing, itemSide, itemSide,
 								pixmap);
@@ -168,22 +176,55 @@ void drawBadges(QPainter *painter, const QStyleOptionViewItemV4 &option, BaseIns
 	painter->translate(-option.rect.topLeft());
 }
 
-static QSize viewItemTextSize(const QStyleOptionViewItemV4 *option)
+ListViewDelegate::CachedText *ListViewDelegate::cachedText(const QStyleOptionViewItemV4 &opt,
+														   int width) const
 {
-	QStyle *style = option->widget ? option->widget->style() : QApplication::style();
+	const Qt::Alignment alignment = QStyle::visualAlignment(opt.direction, opt.displayAlignment);
+	const QString key = QString("%1|%2|%3|%4|")
+							.arg(width)
+							.arg(opt.direction)
+							.arg(alignment)
+							.arg(opt.font.key()) +
+						opt.text;
+	if (auto cached = m_textCache.object(key))
+	{
+		return cached;
+	}
+
+	auto cached = new CachedText();
 	QTextOption textOption;
 	textOption.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
-	QTextLayout textLayout;
-	textLayout.setTextOption(textOption);
-	textLayout.setFont(option->font);
-	textLayout.setText(option->text);
-	const int textMargin =
-		style->pixelMetric(QStyle::PM_FocusFrameHMargin, option, option->widget) + 1;
-	QRect bounds(0, 0, 100 - 2 * textMargin, 600);
-	qreal height = 0, widthUsed = 0;
-	viewItemTextLayout(textLayout, bounds.width(), height, widthUsed);
-	const QSize size(qCeil(widthUsed), qCeil(height));
-	return QSize(size.width() + 2 * textMargin, size.height());
+	textOption.setTextDirection(opt.direction);
+	textOption.setAlignment(alignment);
+	cached->layout.setTextOption(textOption);
+	cached->layout.setFont(opt.font);
+	cached->layout.setText(opt.text);
+	viewItemTextLayout(cached->layout, width, cached->height, cached->widthUsed);
+	m_textCache.insert(key, cached);
+	return cached;
+}
+
+QPixmap ListViewDelegate::cachedIcon(const QStyleOptionViewItemV4 &opt, const QSize &size,
+									 QIcon::Mode mode, QIcon::State state) const
+{
+	// the selected and disabled modes are generated by the style, from the palette
+	QStyle *style = opt.widget ? opt.widget->style() : QApplication::style();
+	const QString key = QString("%1|%2x%3|%4|%5|%6|%7")
+							.arg(opt.icon.cacheKey())
+							.arg(size.width())
+							.arg(size.height())
+							.arg(mode)
+							.arg(state)
+							.arg(opt.palette.cacheKey())
+							.arg((quintptr)style);
+	if (auto cached = m_iconCache.object(key))
+	{
+		return *cached;
+	}
+	QPixmap pixmap = opt.icon.pixmap(size, mode, state);
+	const int cost = qMax(1, pixmap.width() * pixmap.height() * pixmap.depth() / (8 * 1024));
+	m_iconCache.insert(key, new QPixmap(pixmap), cost);
+	return pixmap;
 }
 
 void ListViewDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
@@ -277,7 +318,13 @@ void ListViewDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opti
 		QIcon::State state = opt.state & QStyle::State_Open ? QIcon::On : QIcon::Off;
 
 		iconbox.setHeight(iconSize);
-		opt.icon.paint(painter, iconbox, Qt::AlignCenter, mode, state);
+		const QPixmap pixmap = cachedIcon(opt, QSize(iconSize, iconSize), mode, state);
+		if (!pixmap.isNull())
+		{
+			const QRect pixmapRect = QStyle::alignedRect(
+				opt.direction, Qt::AlignCenter, pixmap.size() / pixmap.devicePixelRatio(), iconbox);
+			painter->drawPixmap(pixmapRect, pixmap);
+		}
 	}
 	// set the text colors
 	QPalette::ColorGroup cg =
@@ -294,26 +341,15 @@ void ListViewDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opti
 	}
 
 	// draw the text
-	QTextOption textOption;
-	textOption.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
-	textOption.setTextDirection(opt.direction);
-	textOption.setAlignment(QStyle::visualAlignment(opt.direction, opt.displayAlignment));
-	QTextLayout textLayout;
-	textLayout.setTextOption(textOption);
-	textLayout.setFont(opt.font);
-	textLayout.setText(opt.text);
-
-	qreal width, height;
-	viewItemTextLayout(textLayout, textRect.width(), height, width);
-
-	const int lineCount = textLayout.lineCount();
+	const CachedText *text = cachedText(opt, textRect.width());
+	const int lineCount = text->layout.lineCount();
 
 	const QRect layoutRect = QStyle::alignedRect(
-		opt.direction, opt.displayAlignment, QSize(textRect.width(), int(height)), textRect);
+		opt.direction, opt.displayAlignment, QSize(textRect.width(), int(text->height)), textRect);
 	const QPointF position = layoutRect.topLeft();
 	for (int i = 0; i < lineCount; ++i)
 	{
-		const QTextLine line = textLayout.lineAt(i);
+		const QTextLine line = text->layout.lineAt(i);
 		line.draw(painter, position);
 	}
 
@@ -345,8 +381,8 @@ QSize ListViewDelegate::sizeHint(const QStyleOptionViewItem &option,
 	const int textMargin =
 		style->pixelMetric(QStyle::PM_FocusFrameHMargin, &option, opt.widget) + 1;
 	int height = 48 + textMargin * 2 + 5; // TODO: turn constants into variables
-	QSize szz = viewItemTextSize(&opt);
-	height += szz.height();
+	// same width as in paint(), so the layout done here is reused there
+	height += qCeil(cachedText(opt, 100 - 2 * textMargin)->height);
 	// FIXME: maybe the icon items could scale and keep proportions?
 	QSize sz(100, height);
 	return sz;
@@ -356,7 +392,10 @@ QPixmap ListViewDelegate::requestBadgePixmap(const QString &key)
 {
 	if (!m_pixmapCache.contains(key))
 	{
-		m_pixmapCache.insert(key, new QPixmap(":/icons/badges/" + key + ".png"));
+		// only ever drawn at one size, so scale them once
+		m_pixmapCache.insert(key, new QPixmap(QPixmap(":/icons/badges/" + key + ".png")
+												  .scaled(BADGE_SIZE, BADGE_SIZE, Qt::KeepAspectRatio,
+														  Qt::FastTransformation)));
 	}
 	return *m_pixmapCache.object(key);
 }
@@ -17,6 +17,7 @@
 
 #include <QStyledItemDelegate>
 #include <QCache>
+#include <QTextLayout>
 
 class ListViewDelegate : public QStyledItemDelegate
 {
@@ -30,6 +31,24 @@ protected:
 			   const QModelIndex &index) const;
 	QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const;
 
+private:
+	/// text laid out for one width and font, ready to be drawn
+	struct CachedText
+	{
+		QTextLayout layout;
+		qreal height = 0;
+		qreal widthUsed = 0;
+	};
+	CachedText *cachedText(const QStyleOptionViewItemV4 &opt, int width) const;
+	QPixmap cachedIcon(const QStyleOptionViewItemV4 &opt, const QSize &size, QIcon::Mode mode,
+					   QIcon::State state) const;
+
 private:
 	static QCache<QString, QPixmap> m_pixmapCache;
+	/*
+	 * The keys are made of everything that goes into the result (text, icon, font, palette...),
+	 * so changed data or style simply stop matching and the old entries age out.
+	 */
+	mutable QCache<QString, CachedText> m_textCache;
+	mutable QCache<QString, QPixmap> m_iconCache;
 };
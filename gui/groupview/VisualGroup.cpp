@@ -18,17 +18,16 @@ VisualGroup::VisualGroup(const VisualGroup *other)
 
 void VisualGroup::update()
 {
-	auto temp_items = items();
 	auto itemsPerRow = view->itemsPerRow();
 
-	int numRows = qMax(1, qCeil((qreal)temp_items.size() / (qreal)itemsPerRow));
+	int numRows = qMax(1, qCeil((qreal)m_items.size() / (qreal)itemsPerRow));
 	rows = QVector<VisualRow>(numRows);
 
 	int maxRowHeight = 0;
 	int positionInRow = 0;
 	int currentRow = 0;
 	int offsetFromTop = 0;
-	for (auto item: temp_items)
+	for (auto item: m_items)
 	{
 		if(positionInRow == itemsPerRow)
 		{
@@ -39,21 +38,51 @@ void VisualGroup::update()
 			positionInRow = 0;
 			maxRowHeight = 0;
 		}
-		auto itemHeight = view->itemDelegate()->sizeHint(view->viewOptions(), item).height();
+		auto itemHeight = view->itemSizeHint(item).height();
 		if(itemHeight > maxRowHeight)
 		{
 			maxRowHeight = itemHeight;
 		}
 		rows[currentRow].items.append(item);
+		view->setItemLayout(item.row(), this, currentRow, positionInRow);
 		positionInRow++;
 	}
 	rows[currentRow].height = maxRowHeight;
 	rows[currentRow].top = offsetFromTop;
+	dirty = false;
+}
+
+void VisualGroup::shiftRows(int first, int delta)
+{
+	auto model = view->model();
+	auto shift = [&](QModelIndex &item)
+	{
+		if (item.row() >= first)
+		{
+			item = model->index(item.row() + delta, 0);
+		}
+	};
+	for (auto &item : m_items)
+	{
+		shift(item);
+	}
+	for (auto &row : rows)
+	{
+		for (auto &item : row.items)
+		{
+			shift(item);
+		}
+	}
 }
 
 QPair<int, int> VisualGroup::positionOf(const QModelIndex &index) const
 {
-	int x = 0;
+	auto layout = view->itemLayout(index.row());
+	if (layout.group == this)
+	{
+		return qMakePair(layout.column, layout.row);
+	}
+	// the layout isn't up to date, look for it the hard way
 	int y = 0;
 	for (auto & row: rows)
 	{
@@ -66,7 +95,7 @@ QPair<int, int> VisualGroup::positionOf(const QModelIndex &index) const
 		}
 		y++;
 	}
-	return qMakePair(x, y);
+	return qMakePair(0, y);
 }
 
 int VisualGroup::rowTopOf(const QModelIndex &index) const
@@ -285,17 +314,3 @@ int VisualGroup::verticalPosition() const
 {
 	return m_verticalPosition;
 }
-
-QList<QModelIndex> VisualGroup::items() const
-{
-	QList<QModelIndex> indices;
-	for (int i = 0; i < view->model()->rowCount(); ++i)
-	{
-		const QModelIndex index = view->model()->index(i, 0);
-		if (index.data(GroupViewRoles::GroupRole).toString() == text)
-		{
-			indices.append(index);
-		}
-	}
-	return indices;
-}
@@ -37,11 +37,19 @@ struct VisualGroup
 	QVector<VisualRow> rows;
 	int firstItemIndex = 0;
 	int m_verticalPosition = 0;
+	/// the items of the group, in model order. Filled in by GroupView.
+	QList<QModelIndex> m_items;
+	/// true if the items need to be flowed into the rows again
+	bool dirty = true;
 
 /* logic */
-	/// update the internal list of items and flow them into the rows.
+	/// flow the items into the rows.
 	void update();
 
+	/// renumber the items from model row \a first on by \a delta, after rows were inserted
+	/// or removed in front of them. the layout stays as it is.
+	void shiftRows(int first, int delta);
+
 	/// draw the header at y-position.
 	void drawHeader(QPainter *painter, const QStyleOptionViewItem &option);
 
@@ -85,7 +93,10 @@ struct VisualGroup
 	/// shoot! BANG! what did we hit?
 	HitResults hitScan (const QPoint &pos) const;
 
-	QList<QModelIndex> items() const;
+	QList<QModelIndex> items() const
+	{
+		return m_items;
+	}
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(VisualGroup::HitResults)
@@ -36,6 +36,9 @@ bool InstanceSettingsPage::apply()
 
 void InstanceSettingsPage::applySettings()
 {
+	// all of it is saved in one go
+	m_settings->beginTransaction();
+
 	// Console
 	bool console = ui->consoleSettingsBox->isChecked();
 	m_settings->set("OverrideConsole", console);
@@ -123,6 +126,8 @@ void InstanceSettingsPage::applySettings()
 		m_settings->reset("PreLaunchCommand");
 		m_settings->reset("PostExitCommand");
 	}
+
+	m_settings->commitTransaction();
 }
 
 void InstanceSettingsPage::loadSettings()
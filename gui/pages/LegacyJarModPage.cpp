@@ -101,8 +101,8 @@ bool LegacyJarModPage::eventFilter(QObject *obj, QEvent *ev)
 
 void LegacyJarModPage::on_addForgeBtn_clicked()
 {
-	VersionSelectDialog vselect(MMC->forgelist().get(), tr("Select Forge version"), this);
-	vselect.setExactFilter(1, m_inst->intendedVersionId());
+	ForgeMinecraftVersionList forgeVersions(MMC->forgelist(), m_inst->intendedVersionId());
+	VersionSelectDialog vselect(&forgeVersions, tr("Select Forge version"), this);
 	if (vselect.exec() && vselect.selectedVersion())
 	{
 		ForgeVersionPtr forge =
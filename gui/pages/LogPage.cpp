@@ -4,10 +4,10 @@
 #include "MultiMC.h"
 
 #include <QIcon>
-#include <QScrollBar>
 #include <QShortcut>
 
 #include "logic/MinecraftProcess.h"
+#include "logic/LogModel.h"
 #include "gui/GuiUtil.h"
 
 LogPage::LogPage(MinecraftProcess *proc, QWidget *parent)
@@ -17,9 +17,16 @@ LogPage::LogPage(MinecraftProcess *proc, QWidget *parent)
 	ui->tabWidget->tabBar()->hide();
 	connect(m_process, SIGNAL(log(QString, MessageLevel::Enum)), this,
 			SLOT(write(QString, MessageLevel::Enum)));
+	connect(m_process, SIGNAL(resourceUsage(ProcessResourceSample)), this,
+			SLOT(onResourceUsage(ProcessResourceSample)));
+	ui->resourceLabel->setVisible(ProcessMonitor::isSupported());
 
-	// create the format and set its font
-	defaultFormat = new QTextCharFormat(ui->text->currentCharFormat());
+	// the log lives in a bounded model, shown by a view that only paints what is visible
+	m_model = new LogModel(this);
+	m_model->setMaxLines(MMC->settings()->get("ConsoleMaxLines").toInt());
+	ui->text->setModel(m_model);
+
+	// set the font
 	QString fontFamily = MMC->settings()->get("ConsoleFont").toString();
 	bool conversionOk = false;
 	int fontSize = MMC->settings()->get("ConsoleFontSize").toInt(&conversionOk);
@@ -27,7 +34,7 @@ LogPage::LogPage(MinecraftProcess *proc, QWidget *parent)
 	{
 		fontSize = 11;
 	}
-	defaultFormat->setFont(QFont(fontFamily, fontSize));
+	ui->text->setFont(QFont(fontFamily, fontSize));
 
 	auto findShortcut = new QShortcut(QKeySequence(QKeySequence::Find), this);
 	connect(findShortcut, SIGNAL(activated()), SLOT(findActivated()));
@@ -36,12 +43,15 @@ LogPage::LogPage(MinecraftProcess *proc, QWidget *parent)
 	connect(ui->searchBar, SIGNAL(returnPressed()), SLOT(on_findButton_clicked()));
 	auto findPreviousShortcut = new QShortcut(QKeySequence(QKeySequence::FindPrevious), this);
 	connect(findPreviousShortcut, SIGNAL(activated()), SLOT(findPreviousActivated()));
+
+	// the model keeps a search index, so the match count can follow every keystroke
+	connect(ui->searchBar, SIGNAL(textChanged(QString)), SLOT(updateMatchCount()));
+	connect(ui->searchLevelBox, SIGNAL(currentIndexChanged(int)), SLOT(updateMatchCount()));
 }
 
 LogPage::~LogPage()
 {
 	delete ui;
-	delete defaultFormat;
 }
 
 bool LogPage::apply()
@@ -56,17 +66,17 @@ bool LogPage::shouldDisplay() const
 
 void LogPage::on_btnPaste_clicked()
 {
-	GuiUtil::uploadPaste(ui->text->toPlainText(), this);
+	GuiUtil::uploadPaste(m_model->toPlainText(), this);
 }
 
 void LogPage::on_btnCopy_clicked()
 {
-	GuiUtil::setClipboardText(ui->text->toPlainText());
+	GuiUtil::setClipboardText(m_model->toPlainText());
 }
 
 void LogPage::on_btnClear_clicked()
 {
-	ui->text->clear();
+	m_model->clear();
 }
 
 void LogPage::on_trackLogCheckbox_clicked(bool checked)
@@ -87,14 +97,36 @@ void LogPage::on_findButton_clicked()
 	}
 }
 
+void LogPage::onResourceUsage(ProcessResourceSample sample)
+{
+	const double mebibyte = 1024.0 * 1024.0;
+	ui->resourceLabel->setText(
+		tr("Memory: %1 MiB, CPU: %2%, Threads: %3, Disk I/O: %4 / %5 MiB")
+			.arg(sample.residentBytes / mebibyte, 0, 'f', 0)
+			.arg(sample.cpuUsage, 0, 'f', 0)
+			.arg(sample.threads)
+			.arg(sample.readBytes / mebibyte, 0, 'f', 1)
+			.arg(sample.writtenBytes / mebibyte, 0, 'f', 1));
+	// output may have been dropped entirely since the last write()
+	updateFilteredCount();
+}
+
+void LogPage::updateFilteredCount()
+{
+	const int dropped = m_process->droppedLines();
+	if (dropped)
+	{
+		ui->filteredLabel->setText(tr("%n line(s) filtered", "", dropped));
+	}
+}
+
 void LogPage::findActivated()
 {
 	// focus the search bar if it doesn't have focus
 	if (!ui->searchBar->hasFocus())
 	{
-		auto searchForCursor = ui->text->textCursor();
-		auto searchForString = searchForCursor.selectedText();
-		if (searchForString.size())
+		auto searchForString = ui->text->selectedText();
+		if (searchForString.size() && !searchForString.contains('\n'))
 		{
 			ui->searchBar->setText(searchForString);
 		}
@@ -108,7 +140,7 @@ void LogPage::findNextActivated()
 	auto toSearch = ui->searchBar->text();
 	if (toSearch.size())
 	{
-		ui->text->find(toSearch);
+		find(toSearch, false);
 	}
 }
 
@@ -117,106 +149,62 @@ void LogPage::findPreviousActivated()
 	auto toSearch = ui->searchBar->text();
 	if (toSearch.size())
 	{
-		ui->text->find(toSearch, QTextDocument::FindBackward);
+		find(toSearch, true);
 	}
 }
 
-void LogPage::write(QString data, MessageLevel::Enum mode)
+quint32 LogPage::searchLevelMask() const
 {
-	if (!m_write_active)
-	{
-		if (mode != MessageLevel::PrePost && mode != MessageLevel::MultiMC)
-		{
-			return;
-		}
-	}
-
-	// save the cursor so it can be restored.
-	auto savedCursor = ui->text->cursor();
-
-	QScrollBar *bar = ui->text->verticalScrollBar();
-	int max_bar = bar->maximum();
-	int val_bar = bar->value();
-	if (isVisible())
-	{
-		if (m_scroll_active)
-		{
-			m_scroll_active = (max_bar - val_bar) <= 1;
-		}
-		else
-		{
-			m_scroll_active = val_bar == max_bar;
-		}
-	}
-	if (data.endsWith('\n'))
-		data = data.left(data.length() - 1);
-	QStringList paragraphs = data.split('\n');
-	QStringList filtered;
-	for (QString &paragraph : paragraphs)
+	const quint32 errors = (1u << MessageLevel::Error) | (1u << MessageLevel::Fatal);
+	switch (ui->searchLevelBox->currentIndex())
 	{
-		//TODO: implement filtering here.
-		filtered.append(paragraph);
+	case 1:
+		return errors | (1u << MessageLevel::Warning);
+	case 2:
+		return errors;
+	default:
+		return LogModel::AllLevels;
 	}
-	QListIterator<QString> iter(filtered);
-	QTextCharFormat format(*defaultFormat);
+}
 
-	switch(mode)
+void LogPage::updateMatchCount()
+{
+	auto toSearch = ui->searchBar->text();
+	if (toSearch.isEmpty())
 	{
-		case MessageLevel::MultiMC:
-		{
-			format.setForeground(QColor("blue"));
-			break;
-		}
-		case MessageLevel::Debug:
-		{
-			format.setForeground(QColor("green"));
-			break;
-		}
-		case MessageLevel::Warning:
-		{
-			format.setForeground(QColor("orange"));
-			break;
-		}
-		case MessageLevel::Error:
-		{
-			format.setForeground(QColor("red"));
-			break;
-		}
-		case MessageLevel::Fatal:
-		{
-			format.setForeground(QColor("red"));
-			format.setBackground(QColor("black"));
-			break;
-		}
-		case MessageLevel::PrePost:
-		{
-			format.setForeground(QColor("grey"));
-			break;
-		}
-		case MessageLevel::Info:
-		case MessageLevel::Message:
-		default:
-		{
-			// do nothing, keep original
-		}
+		ui->matchLabel->clear();
+		return;
 	}
+	ui->matchLabel->setText(
+		tr("%n match(es)", "", m_model->countMatches(toSearch, searchLevelMask())));
+}
 
-	while (iter.hasNext())
+void LogPage::find(const QString &text, bool backwards)
+{
+	int start = ui->text->currentIndex().isValid() ? ui->text->currentIndex().row() : -1;
+	int row = m_model->find(text, start, backwards, searchLevelMask());
+	if (row != -1)
 	{
-		// append a paragraph/line
-		auto workCursor = ui->text->textCursor();
-		workCursor.movePosition(QTextCursor::End);
-		workCursor.insertText(iter.next(), format);
-		workCursor.insertBlock();
+		auto index = m_model->index(row);
+		ui->text->setCurrentIndex(index);
+		ui->text->scrollTo(index, QAbstractItemView::PositionAtCenter);
 	}
+	updateMatchCount();
+}
 
-	if (isVisible())
+void LogPage::write(QString data, MessageLevel::Enum mode)
+{
+	if (!m_write_active)
 	{
-		if (m_scroll_active)
+		if (mode != MessageLevel::PrePost && mode != MessageLevel::MultiMC)
 		{
-			bar->setValue(bar->maximum());
+			return;
 		}
-		m_last_scroll_value = bar->value();
 	}
-	ui->text->setCursor(savedCursor);
+
+	// filtering is done by MinecraftProcess, before lines get here
+	if (data.endsWith('\n'))
+		data = data.left(data.length() - 1);
+	m_model->append(mode, data.split('\n'));
+	updateFilteredCount();
 }
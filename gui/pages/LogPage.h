@@ -24,11 +24,11 @@
 
 class EnabledItemFilter;
 class MinecraftProcess;
+class LogModel;
 namespace Ui
 {
 class LogPage;
 }
-class QTextCharFormat;
 
 class LogPage : public QWidget, public BasePage
 {
@@ -71,17 +71,21 @@ private slots:
 	void on_trackLogCheckbox_clicked(bool checked);
 
 	void on_findButton_clicked();
+	void onResourceUsage(ProcessResourceSample sample);
 	void findActivated();
 	void findNextActivated();
 	void findPreviousActivated();
+	void updateMatchCount();
+
+private:
+	void find(const QString &text, bool backwards);
+	void updateFilteredCount();
+	/// levels the search is restricted to, as a LogModel level mask
+	quint32 searchLevelMask() const;
 
 private:
 	Ui::LogPage *ui;
 	MinecraftProcess *m_process;
-	int m_last_scroll_value = 0;
-	bool m_scroll_active = true;
-	int m_saved_offset = 0;
+	LogModel *m_model;
 	bool m_write_active = true;
-
-	QTextCharFormat * defaultFormat;
 };
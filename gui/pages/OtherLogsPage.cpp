@@ -16,22 +16,40 @@
 #include "OtherLogsPage.h"
 #include "ui_OtherLogsPage.h"
 
+#include <QApplication>
 #include <QFileDialog>
 #include <QMessageBox>
+#include <QShortcut>
 
 #include "gui/GuiUtil.h"
 #include "logic/RecursiveFileSystemWatcher.h"
 #include "logic/BaseInstance.h"
+#include "logic/FileLogModel.h"
+
+// past this, copying or uploading the whole log would only hang the GUI
+#define MAX_WHOLE_LOG_SIZE 10000000ll
 
 OtherLogsPage::OtherLogsPage(BaseInstance *instance, QWidget *parent)
 	: QWidget(parent), ui(new Ui::OtherLogsPage), m_instance(instance),
-	  m_watcher(new RecursiveFileSystemWatcher(this))
+	  m_watcher(new RecursiveFileSystemWatcher(this)), m_model(new FileLogModel(this))
 {
 	ui->setupUi(this);
 	ui->tabWidget->tabBar()->hide();
+	ui->text->setModel(m_model);
+	connect(m_model, SIGNAL(found(int)), SLOT(searchFinished(int)));
+	connect(m_model, SIGNAL(loadFailed(QString)), SLOT(loadFailed(QString)));
+
+	auto findShortcut = new QShortcut(QKeySequence(QKeySequence::Find), this);
+	connect(findShortcut, SIGNAL(activated()), SLOT(findActivated()));
+	auto findNextShortcut = new QShortcut(QKeySequence(QKeySequence::FindNext), this);
+	connect(findNextShortcut, SIGNAL(activated()), SLOT(findNextActivated()));
+	connect(ui->searchBar, SIGNAL(returnPressed()), SLOT(on_findButton_clicked()));
+	auto findPreviousShortcut = new QShortcut(QKeySequence(QKeySequence::FindPrevious), this);
+	connect(findPreviousShortcut, SIGNAL(activated()), SLOT(findPreviousActivated()));
 
-	m_watcher->setFileExpression("(.*\\.log(\\.[0-9]*)?$)|(crash-.*\\.txt)");
-	m_watcher->setRootDir(QDir::current().absoluteFilePath(m_instance->minecraftRoot()));
+	m_watcher->setFileExpression("(.*\\.log(\\.[0-9]*)?(\\.gz)?$)|(crash-.*\\.txt)");
+	// the whole instance, so MultiMC's own session logs (in multimc-logs) show up too
+	m_watcher->setRootDir(QDir::current().absoluteFilePath(m_instance->instanceRoot()));
 
 	connect(m_watcher, &RecursiveFileSystemWatcher::filesChanged, this,
 			&OtherLogsPage::populateSelectLogBox);
@@ -76,10 +94,10 @@ void OtherLogsPage::on_selectLogBox_currentIndexChanged(const int index)
 		file = ui->selectLogBox->itemText(index);
 	}
 
-	if (file.isEmpty() || !QFile::exists(m_instance->minecraftRoot() + "/" + file))
+	if (file.isEmpty() || !QFile::exists(m_instance->instanceRoot() + "/" + file))
 	{
 		m_currentFile = QString();
-		ui->text->clear();
+		m_model->close();
 		setControlsEnabled(false);
 	}
 	else
@@ -92,37 +110,47 @@ void OtherLogsPage::on_selectLogBox_currentIndexChanged(const int index)
 
 void OtherLogsPage::on_btnReload_clicked()
 {
-	QFile file(m_instance->minecraftRoot() + "/" + m_currentFile);
-	if (!file.open(QFile::ReadOnly))
+	const QString path = m_instance->instanceRoot() + "/" + m_currentFile;
+	// the file is mapped and indexed in the background, so there is no size limit here
+	if (!m_model->open(path))
 	{
 		setControlsEnabled(false);
 		ui->btnReload->setEnabled(true); // allow reload
-		m_currentFile = QString();
 		QMessageBox::critical(this, tr("Error"), tr("Unable to open %1 for reading: %2")
-													 .arg(m_currentFile, file.errorString()));
+													 .arg(m_currentFile, m_model->errorString()));
+		m_currentFile = QString();
 	}
-	else
+}
+
+void OtherLogsPage::loadFailed(QString reason)
+{
+	QMessageBox::critical(this, tr("Error"),
+						  tr("Unable to read %1: %2").arg(m_currentFile, reason));
+}
+
+QString OtherLogsPage::wholeLog()
+{
+	if (m_model->size() >= MAX_WHOLE_LOG_SIZE)
 	{
-		if (file.size() < 10000000ll)
-		{
-			ui->text->setPlainText(QString::fromUtf8(file.readAll()));
-		}
-		else
-		{
-			ui->text->setPlainText(
-				tr("The file (%1) is too big. You may want to open it in a viewer optimized "
-				   "for large files.").arg(file.fileName()));
-		}
+		QMessageBox::warning(this, tr("Error"),
+							 tr("The file (%1) is too big. You may want to open it in a viewer "
+								"optimized for large files.").arg(m_currentFile));
+		return QString();
 	}
+	return m_model->toPlainText();
 }
 
 void OtherLogsPage::on_btnPaste_clicked()
 {
-	GuiUtil::uploadPaste(ui->text->toPlainText(), this);
+	auto text = wholeLog();
+	if (!text.isNull())
+		GuiUtil::uploadPaste(text, this);
 }
 void OtherLogsPage::on_btnCopy_clicked()
 {
-	GuiUtil::setClipboardText(ui->text->toPlainText());
+	auto text = wholeLog();
+	if (!text.isNull())
+		GuiUtil::setClipboardText(text);
 }
 void OtherLogsPage::on_btnDelete_clicked()
 {
@@ -132,12 +160,19 @@ void OtherLogsPage::on_btnDelete_clicked()
 	{
 		return;
 	}
-	QFile file(m_instance->minecraftRoot() + "/" + m_currentFile);
+	// the model may still be reading the file
+	m_model->close();
+	QFile file(m_instance->instanceRoot() + "/" + m_currentFile);
 	if (!file.remove())
 	{
 		QMessageBox::critical(this, tr("Error"), tr("Unable to delete %1: %2")
 													 .arg(m_currentFile, file.errorString()));
+		on_btnReload_clicked();
+		return;
 	}
+	m_currentFile = QString();
+	setControlsEnabled(false);
+	populateSelectLogBox();
 }
 
 void OtherLogsPage::setControlsEnabled(const bool enabled)
@@ -147,4 +182,68 @@ void OtherLogsPage::setControlsEnabled(const bool enabled)
 	ui->btnCopy->setEnabled(enabled);
 	ui->btnPaste->setEnabled(enabled);
 	ui->text->setEnabled(enabled);
+	ui->searchBar->setEnabled(enabled);
+	ui->findButton->setEnabled(enabled);
+}
+
+void OtherLogsPage::on_findButton_clicked()
+{
+	auto modifiers = QApplication::keyboardModifiers();
+	if (modifiers & Qt::ShiftModifier)
+	{
+		findPreviousActivated();
+	}
+	else
+	{
+		findNextActivated();
+	}
+}
+
+void OtherLogsPage::findActivated()
+{
+	// focus the search bar if it doesn't have focus
+	if (!ui->searchBar->hasFocus())
+	{
+		auto searchForString = ui->text->selectedText();
+		if (searchForString.size() && !searchForString.contains('\n'))
+		{
+			ui->searchBar->setText(searchForString);
+		}
+		ui->searchBar->setFocus();
+		ui->searchBar->selectAll();
+	}
+}
+
+void OtherLogsPage::findNextActivated()
+{
+	auto toSearch = ui->searchBar->text();
+	if (toSearch.size())
+	{
+		find(toSearch, false);
+	}
+}
+
+void OtherLogsPage::findPreviousActivated()
+{
+	auto toSearch = ui->searchBar->text();
+	if (toSearch.size())
+	{
+		find(toSearch, true);
+	}
+}
+
+void OtherLogsPage::find(const QString &text, bool backwards)
+{
+	// the search runs in a worker thread and ends up in searchFinished()
+	int start = ui->text->currentIndex().isValid() ? ui->text->currentIndex().row() : -1;
+	m_model->find(text, start, backwards);
+}
+
+void OtherLogsPage::searchFinished(int row)
+{
+	if (row < 0)
+		return;
+	auto index = m_model->index(row);
+	ui->text->setCurrentIndex(index);
+	ui->text->scrollTo(index, QAbstractItemView::PositionAtCenter);
 }
@@ -25,6 +25,7 @@ class OtherLogsPage;
 }
 
 class RecursiveFileSystemWatcher;
+class FileLogModel;
 
 class BaseInstance;
 
@@ -62,12 +63,22 @@ private slots:
 	void on_btnPaste_clicked();
 	void on_btnCopy_clicked();
 	void on_btnDelete_clicked();
+	void on_findButton_clicked();
+	void findActivated();
+	void findNextActivated();
+	void findPreviousActivated();
+	void searchFinished(int row);
+	void loadFailed(QString reason);
 
 private:
 	Ui::OtherLogsPage *ui;
 	BaseInstance *m_instance;
 	RecursiveFileSystemWatcher *m_watcher;
+	FileLogModel *m_model;
 	QString m_currentFile;
 
 	void setControlsEnabled(const bool enabled);
+	void find(const QString &text, bool backwards);
+	/// the whole log, or a null string (after telling the user) if it's too big to handle
+	QString wholeLog();
 };
@@ -14,6 +14,11 @@
 #include <QClipboard>
 #include <QDesktopServices>
 #include <QKeyEvent>
+#include <QImageReader>
+#include <QPointer>
+#include <QScrollBar>
+#include <QAbstractItemView>
+#include <QTimer>
 
 #include <pathutils.h>
 
@@ -22,6 +27,7 @@
 #include "logic/net/NetJob.h"
 #include "logic/screenshots/ImgurUpload.h"
 #include "logic/screenshots/ImgurAlbumCreation.h"
+#include "logic/screenshots/ThumbnailCache.h"
 #include "logic/tasks/SequentialTask.h"
 
 #include "logic/RWStorage.h"
@@ -40,56 +46,82 @@ signals:
 	void resultsFailed(const QString &path);
 };
 
+// thumbnails are this big, stored in the "large" folder of the disk cache
+#define THUMBNAIL_SIZE 256
+// how long to wait for scrolling and resizing to settle before looking at what is visible
+#define VISIBLE_UPDATE_DELAY 50
+// how long to wait before trying a failed thumbnail again, the game may still be writing the file
+#define RETRY_DELAY 1000
+// thumbnails kept in memory, in bytes. The ones dropped come back from the disk cache.
+#define THUMBNAIL_MEMORY (64 * 1024 * 1024)
+#define THUMBNAIL_COST (THUMBNAIL_SIZE * THUMBNAIL_SIZE * 4)
+
+/// set when a thumbnail isn't wanted anymore, because it went out of view
+typedef std::shared_ptr<QAtomicInt> CancelFlag;
+
 class ThumbnailRunnable : public QRunnable
 {
 public:
-	ThumbnailRunnable(QString path, SharedIconCachePtr cache)
+	ThumbnailRunnable(QString path, SharedIconCachePtr cache, const ThumbnailCache &diskCache,
+					  CancelFlag cancelled)
+		: m_diskCache(diskCache), m_cancelled(cancelled)
 	{
 		m_path = path;
 		m_cache = cache;
 	}
 	void run()
 	{
+		if (m_cancelled->load())
+			return;
 		QFileInfo info(m_path);
 		if (info.isDir())
 			return;
 		if ((info.suffix().compare("png", Qt::CaseInsensitive) != 0))
 			return;
-		int tries = 5;
-		while (tries)
+		if (!m_cache->stale(m_path))
+			return;
+		QImage cached = m_diskCache.load(m_path, THUMBNAIL_SIZE);
+		if (!cached.isNull())
 		{
-			if (!m_cache->stale(m_path))
-				return;
-			QImage image(m_path);
-			if (image.isNull())
-			{
-				QThread::msleep(500);
-				tries--;
-				continue;
-			}
-			QImage small;
-			if (image.width() > image.height())
-				small = image.scaledToWidth(512).scaledToWidth(256, Qt::SmoothTransformation);
-			else
-				small = image.scaledToHeight(512).scaledToHeight(256, Qt::SmoothTransformation);
-			auto smallSize = small.size();
-			QPoint offset((256 - small.width()) / 2, (256 - small.height()) / 2);
-			QImage square(QSize(256, 256), QImage::Format_ARGB32);
-			square.fill(Qt::transparent);
-
-			QPainter painter(&square);
-			painter.drawImage(offset, small);
-			painter.end();
-
-			QIcon icon(QPixmap::fromImage(square));
-			m_cache->add(m_path, icon);
+			m_cache->add(m_path, QIcon(QPixmap::fromImage(cached)), THUMBNAIL_COST);
 			m_resultEmitter.emitResultsReady(m_path);
 			return;
 		}
-		m_resultEmitter.emitResultsFailed(m_path);
+
+		// only the thumbnail resolution is produced, the full image is never kept around
+		QImageReader reader(m_path);
+		const QSize size = reader.size();
+		if (size.isValid() && (size.width() > THUMBNAIL_SIZE || size.height() > THUMBNAIL_SIZE))
+		{
+			reader.setScaledSize(size.scaled(THUMBNAIL_SIZE, THUMBNAIL_SIZE, Qt::KeepAspectRatio));
+		}
+		QImage small = reader.read();
+		// files that are still being written fail here. They are retried once they change.
+		if (small.isNull())
+		{
+			m_resultEmitter.emitResultsFailed(m_path);
+			return;
+		}
+		if (m_cancelled->load())
+			return;
+
+		QPoint offset((THUMBNAIL_SIZE - small.width()) / 2, (THUMBNAIL_SIZE - small.height()) / 2);
+		QImage square(QSize(THUMBNAIL_SIZE, THUMBNAIL_SIZE), QImage::Format_ARGB32);
+		square.fill(Qt::transparent);
+
+		QPainter painter(&square);
+		painter.drawImage(offset, small);
+		painter.end();
+
+		m_diskCache.store(m_path, THUMBNAIL_SIZE, square);
+		QIcon icon(QPixmap::fromImage(square));
+		m_cache->add(m_path, icon, THUMBNAIL_COST);
+		m_resultEmitter.emitResultsReady(m_path);
 	}
 	QString m_path;
 	SharedIconCachePtr m_cache;
+	ThumbnailCache m_diskCache;
+	CancelFlag m_cancelled;
 	ThumbnailingResult m_resultEmitter;
 };
 
@@ -99,15 +131,35 @@ class FilterModel : public QIdentityProxyModel
 {
 	Q_OBJECT
 public:
-	explicit FilterModel(QObject *parent = 0) : QIdentityProxyModel(parent)
+	explicit FilterModel(QObject *parent = 0)
+		: QIdentityProxyModel(parent), m_diskCache(QDir("cache/thumbnails").absolutePath())
 	{
-		m_thumbnailingPool.setMaxThreadCount(4);
-		m_thumbnailCache = std::make_shared<SharedIconCache>();
-		m_thumbnailCache->add("placeholder", QIcon::fromTheme("screenshot-placeholder"));
+		m_thumbnailingPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+		m_thumbnailCache = std::make_shared<SharedIconCache>(0, THUMBNAIL_MEMORY);
+		m_placeholder = QIcon::fromTheme("screenshot-placeholder");
 		connect(&watcher, SIGNAL(fileChanged(QString)), SLOT(fileChanged(QString)));
 		// FIXME: the watched file set is not updated when files are removed
+		m_visibleTimer.setSingleShot(true);
+		m_visibleTimer.setInterval(VISIBLE_UPDATE_DELAY);
+		connect(&m_visibleTimer, SIGNAL(timeout()), SLOT(updateVisibleThumbnails()));
+		m_retryTimer.setSingleShot(true);
+		m_retryTimer.setInterval(RETRY_DELAY);
+		connect(&m_retryTimer, SIGNAL(timeout()), SLOT(retryFailed()));
+	}
+	virtual ~FilterModel()
+	{
+		cancelAll();
+		m_thumbnailingPool.waitForDone(500);
+	}
+	/// thumbnails are only made for the items visible in this view
+	void setView(QAbstractItemView *view)
+	{
+		m_view = view;
+		connect(view->verticalScrollBar(), SIGNAL(valueChanged(int)), &m_visibleTimer,
+				SLOT(start()));
+		connect(view->horizontalScrollBar(), SIGNAL(valueChanged(int)), &m_visibleTimer,
+				SLOT(start()));
 	}
-	virtual ~FilterModel() { m_thumbnailingPool.waitForDone(500); }
 	virtual QVariant data(const QModelIndex &proxyIndex, int role = Qt::DisplayRole) const
 	{
 		auto model = sourceModel();
@@ -120,24 +172,19 @@ public:
 		}
 		if (role == Qt::DecorationRole)
 		{
-			QVariant result =
-				sourceModel()->data(mapToSource(proxyIndex), QFileSystemModel::FilePathRole);
-			QString filePath = result.toString();
+			QString filePath = this->filePath(proxyIndex);
 			QIcon temp;
-			if (!watched.contains(filePath))
-			{
-				((QFileSystemWatcher &)watcher).addPath(filePath);
-				((QSet<QString> &)watched).insert(filePath);
-			}
 			if (m_thumbnailCache->get(filePath, temp))
 			{
 				return temp;
 			}
-			if (!m_failed.contains(filePath))
+			// views ask for all the items when laying them out, so this can't tell what's
+			// visible. Have a look at the view once it settles down.
+			if (!m_failed.contains(filePath) && !m_pending.contains(filePath))
 			{
-				((FilterModel *)this)->thumbnailImage(filePath);
+				((QTimer &)m_visibleTimer).start();
 			}
-			return (m_thumbnailCache->get("placeholder"));
+			return m_placeholder;
 		}
 		return sourceModel()->data(mapToSource(proxyIndex), role);
 	}
@@ -159,22 +206,117 @@ public:
 	}
 
 private:
+	QString filePath(const QModelIndex &proxyIndex) const
+	{
+		return sourceModel()->data(mapToSource(proxyIndex), QFileSystemModel::FilePathRole)
+			.toString();
+	}
 	void thumbnailImage(QString path)
 	{
-		auto runnable = new ThumbnailRunnable(path, m_thumbnailCache);
+		// watch the file before reading it, so a write that is still going on isn't missed
+		if (!watched.contains(path))
+		{
+			watcher.addPath(path);
+			watched.insert(path);
+		}
+		CancelFlag cancelled = std::make_shared<QAtomicInt>(0);
+		auto runnable = new ThumbnailRunnable(path, m_thumbnailCache, m_diskCache, cancelled);
 		connect(&(runnable->m_resultEmitter), SIGNAL(resultsReady(QString)),
 				SLOT(thumbnailReady(QString)));
 		connect(&(runnable->m_resultEmitter), SIGNAL(resultsFailed(QString)),
 				SLOT(thumbnailFailed(QString)));
-		((QThreadPool &)m_thumbnailingPool).start(runnable);
+		m_pending.insert(path, cancelled);
+		m_thumbnailingPool.start(runnable);
+	}
+	void cancel(const QString &path)
+	{
+		auto it = m_pending.find(path);
+		if (it != m_pending.end())
+		{
+			it.value()->store(1);
+			m_pending.erase(it);
+		}
+	}
+	void cancelAll()
+	{
+		for (auto cancelled : m_pending)
+		{
+			cancelled->store(1);
+		}
+		m_pending.clear();
+	}
+	QModelIndex indexOf(const QString &path) const
+	{
+		return mapFromSource(((QFileSystemModel *)sourceModel())->index(path));
 	}
 private slots:
-	void thumbnailReady(QString path) { emit layoutChanged(); }
-	void thumbnailFailed(QString path) { m_failed.insert(path); }
+	void updateVisibleThumbnails()
+	{
+		if (!m_view || !sourceModel())
+			return;
+		const QRect viewport = m_view->viewport()->rect();
+		const QModelIndex root = m_view->rootIndex();
+		QSet<QString> visible;
+		// rows go top to bottom, so do the thumbnails
+		for (int row = 0, rows = rowCount(root); row < rows; row++)
+		{
+			const QModelIndex idx = index(row, 0, root);
+			if (!m_view->visualRect(idx).intersects(viewport))
+				continue;
+			const QString path = filePath(idx);
+			visible.insert(path);
+			if (m_pending.contains(path) || m_failed.contains(path) ||
+				!m_thumbnailCache->stale(path))
+				continue;
+			thumbnailImage(path);
+		}
+		// whatever scrolled out of view can wait until it comes back
+		for (auto it = m_pending.begin(); it != m_pending.end();)
+		{
+			if (visible.contains(it.key()))
+			{
+				++it;
+				continue;
+			}
+			it.value()->store(1);
+			it = m_pending.erase(it);
+		}
+	}
+	void thumbnailReady(QString path)
+	{
+		m_pending.remove(path);
+		const QModelIndex idx = indexOf(path);
+		if (idx.isValid())
+			emit dataChanged(idx, idx);
+	}
+	void thumbnailFailed(QString path)
+	{
+		m_pending.remove(path);
+		m_failed.insert(path);
+		// one more go later on, after that it waits for the file to change
+		if (++m_failures[path] == 1)
+		{
+			m_retryTimer.start();
+		}
+	}
+	void retryFailed()
+	{
+		for (auto it = m_failed.begin(); it != m_failed.end();)
+		{
+			if (m_failures.value(*it) == 1)
+				it = m_failed.erase(it);
+			else
+				++it;
+		}
+		m_visibleTimer.start();
+	}
 	void fileChanged(QString filepath)
 	{
+		cancel(filepath);
+		m_failed.remove(filepath);
+		m_failures.remove(filepath);
 		m_thumbnailCache->setStale(filepath);
-		thumbnailImage(filepath);
+		m_visibleTimer.start();
 		// reinsert the path...
 		watcher.removePath(filepath);
 		watcher.addPath(filepath);
@@ -182,8 +324,18 @@ private slots:
 
 private:
 	SharedIconCachePtr m_thumbnailCache;
+	QIcon m_placeholder;
+	ThumbnailCache m_diskCache;
 	QThreadPool m_thumbnailingPool;
+	/// thumbnails being made, so they can be cancelled
+	QHash<QString, CancelFlag> m_pending;
+	QTimer m_visibleTimer;
+	QPointer<QAbstractItemView> m_view;
+	/// thumbnails that failed, they are not tried again until the file changes or a retry
 	QSet<QString> m_failed;
+	/// how often making the thumbnail failed, by path
+	QHash<QString, int> m_failures;
+	QTimer m_retryTimer;
 	QSet<QString> watched;
 	QFileSystemWatcher watcher;
 };
@@ -212,7 +364,8 @@ ScreenshotsPage::ScreenshotsPage(BaseInstance *instance, QWidget *parent)
 	: QWidget(parent), ui(new Ui::ScreenshotsPage)
 {
 	m_model.reset(new QFileSystemModel());
-	m_filterModel.reset(new FilterModel());
+	auto filterModel = new FilterModel();
+	m_filterModel.reset(filterModel);
 	m_filterModel->setSourceModel(m_model.get());
 	m_model->setFilter(QDir::Files | QDir::Writable | QDir::Readable);
 	m_model->setReadOnly(false);
@@ -234,6 +387,7 @@ ScreenshotsPage::ScreenshotsPage(BaseInstance *instance, QWidget *parent)
 	ui->listView->installEventFilter(this);
 	ui->listView->setEditTriggers(0);
 	ui->listView->setItemDelegate(new CenteredEditingDelegate(this));
+	filterModel->setView(ui->listView);
 	connect(ui->listView, SIGNAL(activated(QModelIndex)), SLOT(onItemActivated(QModelIndex)));
 }
 
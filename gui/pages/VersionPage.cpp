@@ -297,8 +297,8 @@ void VersionPage::on_forgeBtn_clicked()
 		m_version->removeDeprecatedVersionFiles();
 		reloadInstanceVersion();
 	}
-	VersionSelectDialog vselect(MMC->forgelist().get(), tr("Select Forge version"), this);
-	vselect.setExactFilter(1, m_inst->currentVersionId());
+	ForgeMinecraftVersionList forgeVersions(MMC->forgelist(), m_inst->currentVersionId());
+	VersionSelectDialog vselect(&forgeVersions, tr("Select Forge version"), this);
 	vselect.setEmptyString(tr("No Forge versions are currently available for Minecraft ") +
 						   m_inst->currentVersionId());
 	if (vselect.exec() && vselect.selectedVersion())
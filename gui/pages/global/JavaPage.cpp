@@ -70,6 +70,7 @@ void JavaPage::applySettings()
 	s->set("JavaPath", ui->javaPathTextBox->text());
 	s->set("JvmArgs", ui->jvmArgsTextBox->text());
 	NagUtils::checkJVMArgs(s->get("JvmArgs").toString(), this->parentWidget());
+	s->set("JavaSearchDirs", ui->javaSearchDirsTextBox->text());
 
 	// Custom Commands
 	s->set("PreLaunchCommand", ui->preLaunchCmdTextBox->text());
@@ -86,6 +87,7 @@ void JavaPage::loadSettings()
 	// Java Settings
 	ui->javaPathTextBox->setText(s->get("JavaPath").toString());
 	ui->jvmArgsTextBox->setText(s->get("JvmArgs").toString());
+	ui->javaSearchDirsTextBox->setText(s->get("JavaSearchDirs").toString());
 
 	// Custom Commands
 	ui->preLaunchCmdTextBox->setText(s->get("PreLaunchCommand").toString());
@@ -62,6 +62,13 @@ MultiMCPage::MultiMCPage(QWidget *parent) : QWidget(parent), ui(new Ui::MultiMCP
 
 	defaultFormat = new QTextCharFormat(ui->fontPreview->currentCharFormat());
 
+	// levels are stored by the names MessageLevel::getLevel() understands
+	ui->logFilterLevelBox->addItem(tr("Debug"), QString("Debug"));
+	ui->logFilterLevelBox->addItem(tr("Info"), QString("Info"));
+	ui->logFilterLevelBox->addItem(tr("Message"), QString("Message"));
+	ui->logFilterLevelBox->addItem(tr("Warning"), QString("Warning"));
+	ui->logFilterLevelBox->addItem(tr("Error"), QString("Error"));
+
 	loadSettings();
 
 	QObject::connect(MMC->updateChecker().get(), &UpdateChecker::channelListLoaded, this,
@@ -308,6 +315,11 @@ void MultiMCPage::applySettings()
 	// Console settings
 	s->set("ShowConsole", ui->showConsoleCheck->isChecked());
 	s->set("AutoCloseConsole", ui->autoCloseConsoleCheck->isChecked());
+	s->set("ConsoleMaxLines", ui->maxLinesSpinBox->value());
+	const int levelIndex = ui->logFilterLevelBox->currentIndex();
+	s->set("LogFilterMinLevel", ui->logFilterLevelBox->itemData(levelIndex).toString());
+	s->set("LogFilterInclude", ui->logFilterIncludeEdit->text());
+	s->set("LogFilterExclude", ui->logFilterExcludeEdit->text());
 	QString consoleFontFamily = ui->consoleFont->currentFont().family();
 	s->set("ConsoleFont", consoleFontFamily);
 	s->set("ConsoleFontSize", ui->fontSizeBox->value());
@@ -388,6 +400,11 @@ void MultiMCPage::loadSettings()
 	// Console settings
 	ui->showConsoleCheck->setChecked(s->get("ShowConsole").toBool());
 	ui->autoCloseConsoleCheck->setChecked(s->get("AutoCloseConsole").toBool());
+	ui->maxLinesSpinBox->setValue(s->get("ConsoleMaxLines").toInt());
+	int levelIndex = ui->logFilterLevelBox->findData(s->get("LogFilterMinLevel").toString());
+	ui->logFilterLevelBox->setCurrentIndex(qMax(0, levelIndex));
+	ui->logFilterIncludeEdit->setText(s->get("LogFilterInclude").toString());
+	ui->logFilterExcludeEdit->setText(s->get("LogFilterExclude").toString());
 	QString fontFamily = MMC->settings()->get("ConsoleFont").toString();
 	QFont consoleFont(fontFamily);
 	ui->consoleFont->setCurrentFont(consoleFont);
@@ -0,0 +1,136 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LogView.h"
+
+#include <QKeyEvent>
+#include <QScrollBar>
+#include <QStyledItemDelegate>
+
+#include "gui/GuiUtil.h"
+#include "logic/LogModel.h"
+
+class LogItemDelegate : public QStyledItemDelegate
+{
+public:
+	explicit LogItemDelegate(QObject *parent = 0) : QStyledItemDelegate(parent)
+	{
+	}
+
+protected:
+	virtual void initStyleOption(QStyleOptionViewItem *option,
+								 const QModelIndex &index) const override
+	{
+		QStyledItemDelegate::initStyleOption(option, index);
+		auto level = (MessageLevel::Enum)index.data(LogModel::LevelRole).toInt();
+		switch (level)
+		{
+		case MessageLevel::MultiMC:
+			option->palette.setColor(QPalette::Text, QColor("blue"));
+			break;
+		case MessageLevel::Debug:
+			option->palette.setColor(QPalette::Text, QColor("green"));
+			break;
+		case MessageLevel::Warning:
+			option->palette.setColor(QPalette::Text, QColor("orange"));
+			break;
+		case MessageLevel::Error:
+			option->palette.setColor(QPalette::Text, QColor("red"));
+			break;
+		case MessageLevel::Fatal:
+			option->palette.setColor(QPalette::Text, QColor("red"));
+			option->backgroundBrush = QBrush(QColor("black"));
+			break;
+		case MessageLevel::PrePost:
+			option->palette.setColor(QPalette::Text, QColor("grey"));
+			break;
+		case MessageLevel::Info:
+		case MessageLevel::Message:
+		default:
+			// do nothing, keep original
+			break;
+		}
+	}
+};
+
+LogView::LogView(QWidget *parent) : QListView(parent)
+{
+	setUniformItemSizes(true);
+	setWordWrap(false);
+	setSelectionMode(QAbstractItemView::ExtendedSelection);
+	setEditTriggers(QAbstractItemView::NoEditTriggers);
+	setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+	setItemDelegate(new LogItemDelegate(this));
+}
+
+void LogView::setModel(QAbstractItemModel *model)
+{
+	QListView::setModel(model);
+	if (model)
+	{
+		connect(model, SIGNAL(rowsAboutToBeInserted(QModelIndex, int, int)),
+				SLOT(rememberScrollPosition()));
+		connect(model, SIGNAL(rowsInserted(QModelIndex, int, int)), SLOT(followLog()));
+	}
+}
+
+QString LogView::selectedText() const
+{
+	auto indexes = selectionModel()->selectedRows();
+	qSort(indexes);
+	QStringList lines;
+	for (auto &index : indexes)
+	{
+		lines.append(index.data().toString());
+	}
+	return lines.join('\n');
+}
+
+void LogView::keyPressEvent(QKeyEvent *event)
+{
+	if (event == QKeySequence::Copy)
+	{
+		GuiUtil::setClipboardText(selectedText());
+		event->accept();
+		return;
+	}
+	QListView::keyPressEvent(event);
+}
+
+void LogView::rememberScrollPosition()
+{
+	// only follow the log if the user didn't scroll away from the end
+	if (isVisible() && !m_scrollPending)
+	{
+		QScrollBar *bar = verticalScrollBar();
+		m_following = (bar->maximum() - bar->value()) <= 1;
+	}
+}
+
+void LogView::followLog()
+{
+	// many batches can arrive in one go, scroll only once after all of them
+	if (m_following && !m_scrollPending)
+	{
+		m_scrollPending = true;
+		QMetaObject::invokeMethod(this, "scrollToEnd", Qt::QueuedConnection);
+	}
+}
+
+void LogView::scrollToEnd()
+{
+	m_scrollPending = false;
+	scrollToBottom();
+}
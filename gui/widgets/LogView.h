@@ -0,0 +1,44 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <QListView>
+
+/**
+ * A view for LogModel.
+ * Rows all have the same height, so only the visible ones are ever laid out and painted.
+ */
+class LogView : public QListView
+{
+	Q_OBJECT
+public:
+	explicit LogView(QWidget *parent = 0);
+	virtual void setModel(QAbstractItemModel *model) override;
+
+	/// text of the selected lines, in order
+	QString selectedText() const;
+
+protected:
+	virtual void keyPressEvent(QKeyEvent *event) override;
+
+private slots:
+	void rememberScrollPosition();
+	void followLog();
+	void scrollToEnd();
+
+private:
+	bool m_following = true;
+	bool m_scrollPending = false;
+};
@@ -37,11 +37,11 @@ BaseInstance::BaseInstance(const QString &rootDir, SettingsObject *settings, QOb
 	m_settings = std::shared_ptr<SettingsObject>(settings);
 	m_rootDir = rootDir;
 
-	m_settings->registerSetting("name", "Unnamed Instance");
-	m_settings->registerSetting("iconKey", "default");
+	m_name = SettingHandle<QString>(m_settings->registerSetting("name", "Unnamed Instance"));
+	m_iconKey = SettingHandle<QString>(m_settings->registerSetting("iconKey", "default"));
 	connect(MMC->icons().get(), SIGNAL(iconUpdated(QString)), SLOT(iconUpdated(QString)));
-	m_settings->registerSetting("notes", "");
-	m_settings->registerSetting("lastLaunchTime", 0);
+	m_notes = SettingHandle<QString>(m_settings->registerSetting("notes", ""));
+	m_lastLaunchTime = SettingHandle<qint64>(m_settings->registerSetting("lastLaunchTime", 0));
 
 	auto globalSettings = MMC->settings();
 
@@ -74,6 +74,9 @@ BaseInstance::BaseInstance(const QString &rootDir, SettingsObject *settings, QOb
 	m_settings->registerOverride(globalSettings->getSetting("ShowConsole"));
 	m_settings->registerOverride(globalSettings->getSetting("AutoCloseConsole"));
 	m_settings->registerOverride(globalSettings->getSetting("LogPrePostOutput"));
+	m_settings->registerOverride(globalSettings->getSetting("LogFilterMinLevel"));
+	m_settings->registerOverride(globalSettings->getSetting("LogFilterInclude"));
+	m_settings->registerOverride(globalSettings->getSetting("LogFilterExclude"));
 }
 
 void BaseInstance::iconUpdated(QString key)
@@ -86,6 +89,8 @@ void BaseInstance::iconUpdated(QString key)
 
 void BaseInstance::nuke()
 {
+	// a save still pending would put instance.cfg (or its temporary file) back into the folder
+	m_settings->discard();
 	QDir(instanceRoot()).removeRecursively();
 	emit nuked(this);
 }
@@ -187,12 +192,12 @@ bool BaseInstance::reload()
 
 qint64 BaseInstance::lastLaunch() const
 {
-	return m_settings->get("lastLaunchTime").value<qint64>();
+	return m_lastLaunchTime.get();
 }
 
 void BaseInstance::setLastLaunch(qint64 val)
 {
-	m_settings->set("lastLaunchTime", val);
+	m_lastLaunchTime.set(val);
 	emit propertiesChanged(this);
 }
 
@@ -215,34 +220,34 @@ QString BaseInstance::group() const
 
 void BaseInstance::setNotes(QString val)
 {
-	m_settings->set("notes", val);
+	m_notes.set(val);
 }
 
 QString BaseInstance::notes() const
 {
-	return m_settings->get("notes").toString();
+	return m_notes.get();
 }
 
 void BaseInstance::setIconKey(QString val)
 {
-	m_settings->set("iconKey", val);
+	m_iconKey.set(val);
 	emit propertiesChanged(this);
 }
 
 QString BaseInstance::iconKey() const
 {
-	return m_settings->get("iconKey").toString();
+	return m_iconKey.get();
 }
 
 void BaseInstance::setName(QString val)
 {
-	m_settings->set("name", val);
+	m_name.set(val);
 	emit propertiesChanged(this);
 }
 
 QString BaseInstance::name() const
 {
-	return m_settings->get("name").toString();
+	return m_name.get();
 }
 
 QString BaseInstance::windowTitle() const
@@ -20,6 +20,7 @@
 #include <QSet>
 
 #include "logic/settings/SettingsObject.h"
+#include "logic/settings/Setting.h"
 
 #include "logic/settings/INIFile.h"
 #include "logic/BaseVersionList.h"
@@ -216,6 +217,13 @@ protected:
 	std::shared_ptr<SettingsObject> m_settings;
 	InstanceFlags m_flags;
 	bool m_isRunning = false;
+
+private:
+	/// read for every instance whenever the instance list is sorted or painted
+	SettingHandle<QString> m_name;
+	SettingHandle<QString> m_iconKey;
+	SettingHandle<QString> m_notes;
+	SettingHandle<qint64> m_lastLaunchTime;
 };
 
 Q_DECLARE_METATYPE(std::shared_ptr<BaseInstance>)
@@ -0,0 +1,387 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileLogModel.h"
+
+#include <QFileInfo>
+#include <QtConcurrentRun>
+
+#include <quagzipfile.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "LogModel.h"
+#include "MessageLevel.h"
+
+// the indexer reports back after every chunk of this many bytes
+#define INDEX_CHUNK_SIZE (4 * 1024 * 1024)
+// gzip files are decompressed in chunks of this many bytes
+#define DECOMPRESS_CHUNK_SIZE (256 * 1024)
+
+static inline char asciiLower(char c)
+{
+	return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+FileLogModel::FileLogModel(QObject *parent) : QAbstractListModel(parent)
+{
+	qRegisterMetaType<QVector<qint64>>("QVector<qint64>");
+	connect(&m_finder, SIGNAL(finished()), SLOT(findFinished()));
+	connect(&m_watcher, SIGNAL(fileChanged(QString)), SLOT(fileChanged(QString)));
+}
+
+FileLogModel::~FileLogModel()
+{
+	close();
+}
+
+bool FileLogModel::open(const QString &path)
+{
+	close();
+
+	if (path.endsWith(".gz"))
+	{
+		// only check that the file is there, the rest happens in a worker thread
+		QFile compressed(path);
+		if (!compressed.open(QIODevice::ReadOnly))
+		{
+			m_error = compressed.errorString();
+			return false;
+		}
+		m_decompressed.reset(new QTemporaryFile());
+		if (!m_decompressed->open())
+		{
+			m_error = m_decompressed->errorString();
+			m_decompressed.reset();
+			return false;
+		}
+		m_decompressed->close();
+		m_indexer = QtConcurrent::run(this, &FileLogModel::decompress, m_generation, path,
+									  m_decompressed->fileName());
+		return true;
+	}
+
+	m_file.setFileName(path);
+	if (!mapFile())
+		return false;
+	m_watcher.addPath(path);
+	return true;
+}
+
+void FileLogModel::fileChanged(const QString &path)
+{
+	// still there and not smaller, so everything mapped is still backed by the file
+	QFileInfo info(path);
+	if (!info.exists() || info.size() >= m_size)
+		return;
+
+	// a new game session started writing it from scratch
+	if (!open(path))
+	{
+		emit loadFailed(m_error);
+	}
+}
+
+bool FileLogModel::mapFile()
+{
+	if (!m_file.open(QIODevice::ReadOnly))
+	{
+		m_error = m_file.errorString();
+		return false;
+	}
+
+	const qint64 size = m_file.size();
+	if (size > 0)
+	{
+		auto data = m_file.map(0, size);
+		if (!data)
+		{
+			m_error = m_file.errorString();
+			m_file.close();
+			return false;
+		}
+		beginResetModel();
+		m_data = (const char *)data;
+		m_size = size;
+		m_lineStarts.append(0);
+		m_indexing = true;
+		endResetModel();
+
+		m_indexer = QtConcurrent::run(this, &FileLogModel::indexLines, m_generation);
+	}
+	return true;
+}
+
+void FileLogModel::decompress(int generation, QString path, QString target)
+{
+	QuaGzipFile in(path);
+	QFile out(target);
+	QString error;
+	if (!in.open(QIODevice::ReadOnly))
+	{
+		error = in.errorString();
+	}
+	else if (!out.open(QIODevice::WriteOnly))
+	{
+		error = out.errorString();
+	}
+	else
+	{
+		// constant memory use, no matter how big the log is
+		QByteArray buffer(DECOMPRESS_CHUNK_SIZE, Qt::Uninitialized);
+		qint64 read;
+		while ((read = in.read(buffer.data(), buffer.size())) > 0)
+		{
+			if (m_cancelIndexing.load())
+				return;
+			if (out.write(buffer.constData(), read) != read)
+			{
+				error = out.errorString();
+				break;
+			}
+		}
+		if (read < 0)
+		{
+			error = in.errorString();
+		}
+	}
+	// everything has to be on disk before it gets mapped
+	out.close();
+	QMetaObject::invokeMethod(this, "decompressed", Qt::QueuedConnection,
+							  Q_ARG(int, generation), Q_ARG(QString, error));
+}
+
+void FileLogModel::decompressed(int generation, QString error)
+{
+	if (generation != m_generation)
+		return;
+
+	if (error.isEmpty())
+	{
+		m_file.setFileName(m_decompressed->fileName());
+		if (mapFile())
+			return;
+		error = m_error;
+	}
+	m_error = error;
+	emit loadFailed(error);
+}
+
+void FileLogModel::close()
+{
+	cancelFind();
+	m_cancelIndexing.store(1);
+	m_indexer.waitForFinished();
+	m_cancelIndexing.store(0);
+
+	// anything the old indexer still has in the event queue is ignored from now on
+	m_generation++;
+
+	if (!m_watcher.files().isEmpty())
+	{
+		m_watcher.removePaths(m_watcher.files());
+	}
+
+	beginResetModel();
+	if (m_data)
+	{
+		m_file.unmap((uchar *)m_data);
+	}
+	m_file.close();
+	m_decompressed.reset();
+	m_error.clear();
+	m_data = nullptr;
+	m_size = 0;
+	m_lineStarts.clear();
+	m_indexing = false;
+	endResetModel();
+}
+
+int FileLogModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+		return 0;
+	// the last line isn't complete until the whole file is indexed
+	if (m_indexing)
+		return m_lineStarts.size() - 1;
+	return m_lineStarts.size();
+}
+
+QVariant FileLogModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
+		return QVariant();
+
+	switch (role)
+	{
+	case Qt::DisplayRole:
+		return line(index.row());
+	case LogModel::LevelRole:
+		// only ever done for the visible rows
+		return MessageLevel::guessLevel(line(index.row()), MessageLevel::Message);
+	default:
+		return QVariant();
+	}
+}
+
+qint64 FileLogModel::lineEnd(int row) const
+{
+	qint64 end = (row + 1 < m_lineStarts.size()) ? m_lineStarts[row + 1] - 1 : m_size;
+	const qint64 start = m_lineStarts[row];
+	if (end > start && m_data[end - 1] == '\n')
+		end--;
+	if (end > start && m_data[end - 1] == '\r')
+		end--;
+	return end;
+}
+
+QString FileLogModel::line(int row) const
+{
+	const qint64 start = m_lineStarts[row];
+	return QString::fromUtf8(m_data + start, lineEnd(row) - start);
+}
+
+QString FileLogModel::toPlainText() const
+{
+	if (!m_data)
+		return QString();
+	return QString::fromUtf8(m_data, m_size);
+}
+
+void FileLogModel::indexLines(int generation)
+{
+	QVector<qint64> lineStarts;
+	for (qint64 chunk = 0; chunk < m_size; chunk += INDEX_CHUNK_SIZE)
+	{
+		if (m_cancelIndexing.load())
+			return;
+
+		const qint64 chunkEnd = qMin(m_size, chunk + INDEX_CHUNK_SIZE);
+		const char *pos = m_data + chunk;
+		const char *end = m_data + chunkEnd;
+		while ((pos = (const char *)memchr(pos, '\n', end - pos)))
+		{
+			const qint64 next = pos - m_data + 1;
+			if (next < m_size)
+				lineStarts.append(next);
+			pos++;
+		}
+
+		QMetaObject::invokeMethod(this, "linesIndexed", Qt::QueuedConnection,
+								  Q_ARG(int, generation), Q_ARG(QVector<qint64>, lineStarts),
+								  Q_ARG(bool, chunkEnd == m_size));
+		lineStarts.clear();
+	}
+}
+
+void FileLogModel::linesIndexed(int generation, QVector<qint64> lineStarts, bool finished)
+{
+	if (generation != m_generation)
+		return;
+
+	const int oldRows = rowCount();
+	const int newRows = m_lineStarts.size() + lineStarts.size() - (finished ? 0 : 1);
+	if (newRows > oldRows)
+	{
+		beginInsertRows(QModelIndex(), oldRows, newRows - 1);
+	}
+	m_lineStarts += lineStarts;
+	m_indexing = !finished;
+	if (newRows > oldRows)
+	{
+		endInsertRows();
+	}
+	if (finished)
+	{
+		emit indexingFinished();
+	}
+}
+
+void FileLogModel::cancelFind()
+{
+	m_cancelFind.store(1);
+	m_finder.waitForFinished();
+	m_cancelFind.store(0);
+}
+
+void FileLogModel::find(const QString &text, int fromRow, bool backwards)
+{
+	cancelFind();
+
+	const int rows = rowCount();
+	if (text.isEmpty() || !rows || (!backwards && fromRow + 1 >= rows) ||
+		(backwards && fromRow == 0))
+	{
+		emit found(-1);
+		return;
+	}
+
+	// only look through the lines indexed so far
+	qint64 from = 0;
+	qint64 to = lineEnd(rows - 1);
+	if (!backwards && fromRow >= 0)
+		from = m_lineStarts[fromRow + 1];
+	else if (backwards && fromRow > 0 && fromRow < rows)
+		to = m_lineStarts[fromRow];
+
+	QByteArray needle = text.toUtf8();
+	for (char &c : needle)
+	{
+		c = asciiLower(c);
+	}
+	m_finder.setFuture(
+		QtConcurrent::run(this, &FileLogModel::findText, needle, from, to, backwards));
+}
+
+qint64 FileLogModel::findText(QByteArray needle, qint64 from, qint64 to, bool backwards)
+{
+	// ASCII case insensitive, leaves multibyte UTF-8 sequences alone
+	const int length = needle.size();
+	const char *pattern = needle.constData();
+	auto matchesAt = [&](qint64 pos)
+	{
+		for (int i = 0; i < length; i++)
+		{
+			if (asciiLower(m_data[pos + i]) != pattern[i])
+				return false;
+		}
+		return true;
+	};
+
+	const qint64 last = to - length;
+	for (qint64 i = 0; i <= last - from; i++)
+	{
+		// check for cancellation every now and then
+		if ((i & 0xFFFFF) == 0 && m_cancelFind.load())
+			return -1;
+		const qint64 pos = backwards ? last - i : from + i;
+		if (matchesAt(pos))
+			return pos;
+	}
+	return -1;
+}
+
+void FileLogModel::findFinished()
+{
+	const qint64 offset = m_finder.result();
+	if (offset < 0)
+	{
+		emit found(-1);
+		return;
+	}
+	auto it = std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset);
+	emit found((it - m_lineStarts.begin()) - 1);
+}
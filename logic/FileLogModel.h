@@ -0,0 +1,123 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QAtomicInt>
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QScopedPointer>
+#include <QTemporaryFile>
+#include <QVector>
+
+/**
+ * A read only list model of the lines of a (possibly huge) log file.
+ *
+ * The file is memory mapped and the line offsets are indexed in a worker thread. Rows show up
+ * as they are indexed, so the beginning of the file can be looked at right away.
+ *
+ * Gzip compressed files (*.gz) are decompressed in a worker thread, chunk by chunk, into a
+ * temporary file that is then mapped like any other.
+ *
+ * Only the size the file had when it was opened is shown, anything written later shows up on
+ * the next open(). If the file gets truncated, it is mapped again, because reading the pages
+ * past its new end would crash.
+ */
+class FileLogModel : public QAbstractListModel
+{
+	Q_OBJECT
+public:
+	explicit FileLogModel(QObject *parent = 0);
+	virtual ~FileLogModel();
+
+	/**
+	 * open a file, replacing the current one. Returns false if it can't be opened.
+	 * Problems found later (in a corrupt gzip file) are reported by loadFailed().
+	 */
+	bool open(const QString &path);
+	void close();
+
+	QString errorString() const
+	{
+		return m_error;
+	}
+	qint64 size() const
+	{
+		return m_size;
+	}
+	bool isIndexing() const
+	{
+		return m_indexing;
+	}
+
+	virtual int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	virtual QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+	QString line(int row) const;
+	/// the whole file as text
+	QString toPlainText() const;
+
+	/**
+	 * @brief look for text in a worker thread. found() is emitted with the result.
+	 * @param fromRow the search starts after this row (before it when going backwards),
+	 *        -1 to search the whole file
+	 */
+	void find(const QString &text, int fromRow, bool backwards);
+
+signals:
+	void indexingFinished();
+	void loadFailed(QString reason);
+	/// emitted when a search is done, with the row that contains the text or -1
+	void found(int row);
+
+private slots:
+	void decompressed(int generation, QString error);
+	void linesIndexed(int generation, QVector<qint64> lineStarts, bool finished);
+	void findFinished();
+	void fileChanged(const QString &path);
+
+private:
+	bool mapFile();
+	void decompress(int generation, QString path, QString target);
+	void indexLines(int generation);
+	qint64 findText(QByteArray needle, qint64 from, qint64 to, bool backwards);
+	qint64 lineEnd(int row) const;
+	void cancelFind();
+
+private:
+	QFile m_file;
+	QString m_error;
+	/// holds the decompressed contents of gzip files
+	QScopedPointer<QTemporaryFile> m_decompressed;
+	/// notices when the mapped file gets truncated
+	QFileSystemWatcher m_watcher;
+	const char *m_data = nullptr;
+	/// the size of the file when it was mapped
+	qint64 m_size = 0;
+	/// offsets of the beginnings of all lines indexed so far
+	QVector<qint64> m_lineStarts;
+	bool m_indexing = false;
+	/// increases with every file opened, so results from old workers can be told apart
+	int m_generation = 0;
+
+	/// cancels the decompression and indexing
+	QAtomicInt m_cancelIndexing;
+	QFuture<void> m_indexer;
+	QAtomicInt m_cancelFind;
+	QFutureWatcher<qint64> m_finder;
+};
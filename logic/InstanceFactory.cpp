@@ -135,6 +135,8 @@ InstanceFactory::InstCreateError InstanceFactory::copyInstance(InstancePtr &newI
 	QDir rootDir(instDir);
 
 	QLOG_DEBUG() << instDir.toUtf8();
+	// the copy has to have the latest settings
+	oldInstance->settings().flush();
 	if (!copyPath(oldInstance->instanceRoot(), instDir))
 	{
 		rootDir.removeRecursively();
@@ -149,6 +151,8 @@ InstanceFactory::InstCreateError InstanceFactory::copyInstance(InstancePtr &newI
 		settings_obj.set("InstanceType", "OneSix");
 	if (inst_type == "LegacyFTB")
 		settings_obj.set("InstanceType", "Legacy");
+	// loadInstance() reads the file again
+	settings_obj.flush();
 
 	oldInstance->copy(instDir);
 
@@ -32,6 +32,7 @@
 #include "logic/minecraft/MinecraftVersionList.h"
 #include "logic/BaseInstance.h"
 #include "logic/InstanceFactory.h"
+#include "logic/StringPool.h"
 #include "logger/QsLog.h"
 #include "gui/groupview/GroupView.h"
 
@@ -95,7 +96,7 @@ QVariant InstanceList::data(const QModelIndex &index, int role) const
 	case Qt::DecorationRole:
 	{
 		QString key = pdata->iconKey();
-		return MMC->icons()->getIcon(key);
+		return MMC->icons()->getViewIcon(key);
 	}
 	// for now.
 	case GroupViewRoles::GroupRole:
@@ -448,6 +449,13 @@ void InstanceList::loadFTBInstances(QMap<QString, QString> &groupMap,
 
 InstanceList::InstListError InstanceList::loadList()
 {
+	// the new instances are read from disk before the old ones go away, so they have to see
+	// any changes that are still waiting to be saved
+	for (auto &instance : m_instances)
+	{
+		instance->settings().flush();
+	}
+
 	// load the instance groups
 	QMap<QString, QString> groupMap;
 	loadGroupList(groupMap);
@@ -488,6 +496,8 @@ InstanceList::InstListError InstanceList::loadList()
 	}
 	endResetModel();
 	emit dataIsInvalid();
+	// the old instances are gone, and with them whatever only they used
+	StringPool::prune();
 	return NoError;
 }
 
@@ -0,0 +1,144 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LogCensor.h"
+
+#include <QQueue>
+#include <QVarLengthArray>
+
+#include <algorithm>
+
+void LogCensor::setReplacements(const QMap<QString, QString> &replacements)
+{
+	m_nodes.clear();
+	m_patterns.clear();
+	m_nodes.append(Node());
+
+	// build the trie
+	for (auto it = replacements.begin(); it != replacements.end(); ++it)
+	{
+		if (it.key().isEmpty())
+			continue;
+		int state = 0;
+		for (QChar c : it.key())
+		{
+			auto next = m_nodes[state].next.find(c.unicode());
+			if (next == m_nodes[state].next.end())
+			{
+				m_nodes.append(Node());
+				int created = m_nodes.size() - 1;
+				m_nodes[state].next.insert(c.unicode(), created);
+				state = created;
+			}
+			else
+			{
+				state = next.value();
+			}
+		}
+		m_nodes[state].match = m_patterns.size();
+		m_patterns.append({it.key(), it.value()});
+	}
+
+	// link up the failure transitions, breadth first
+	QQueue<int> queue;
+	for (int child : m_nodes[0].next)
+	{
+		queue.enqueue(child);
+	}
+	while (!queue.isEmpty())
+	{
+		int state = queue.dequeue();
+		for (auto it = m_nodes[state].next.constBegin(); it != m_nodes[state].next.constEnd();
+			 ++it)
+		{
+			int child = it.value();
+			int fail = m_nodes[state].fail;
+			while (fail && !m_nodes[fail].next.contains(it.key()))
+			{
+				fail = m_nodes[fail].fail;
+			}
+			auto target = m_nodes[fail].next.find(it.key());
+			if (target != m_nodes[fail].next.end() && target.value() != child)
+			{
+				m_nodes[child].fail = target.value();
+			}
+			// a node without its own match still ends whatever its suffix ends
+			if (m_nodes[child].match == -1)
+			{
+				m_nodes[child].match = m_nodes[m_nodes[child].fail].match;
+			}
+			queue.enqueue(child);
+		}
+	}
+}
+
+int LogCensor::step(int state, ushort c) const
+{
+	while (true)
+	{
+		auto next = m_nodes[state].next.constFind(c);
+		if (next != m_nodes[state].next.constEnd())
+			return next.value();
+		if (!state)
+			return 0;
+		state = m_nodes[state].fail;
+	}
+}
+
+QString LogCensor::censor(const QString &in) const
+{
+	if (m_patterns.isEmpty())
+		return in;
+
+	// find the longest match ending at each position, as (start, pattern) pairs
+	QVarLengthArray<QPair<int, int>, 16> matches;
+	const QChar *data = in.constData();
+	const int size = in.size();
+	int state = 0;
+	for (int i = 0; i < size; i++)
+	{
+		state = step(state, data[i].unicode());
+		int pattern = m_nodes[state].match;
+		if (pattern != -1)
+		{
+			matches.append(qMakePair(i + 1 - m_patterns[pattern].text.size(), pattern));
+		}
+	}
+	if (matches.isEmpty())
+		return in;
+
+	// replace from left to right, the longest one wins when matches overlap
+	std::sort(matches.begin(), matches.end(),
+			  [this](const QPair<int, int> &a, const QPair<int, int> &b)
+	{
+		if (a.first != b.first)
+			return a.first < b.first;
+		return m_patterns[a.second].text.size() > m_patterns[b.second].text.size();
+	});
+	QString out;
+	out.reserve(size);
+	int copied = 0;
+	for (auto &match : matches)
+	{
+		if (match.first < copied)
+			continue;
+		const Pattern &pattern = m_patterns[match.second];
+		out.append(in.midRef(copied, match.first - copied));
+		out.append(pattern.replacement);
+		copied = match.first + pattern.text.size();
+	}
+	out.append(in.midRef(copied));
+	return out;
+}
@@ -0,0 +1,60 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+/**
+ * Replaces private strings (tokens, ids, ...) in log lines with placeholders.
+ *
+ * All the strings are compiled into one Aho-Corasick automaton, so each line is scanned
+ * once, no matter how many strings there are. Lines without anything to censor are
+ * returned as they are, without copying.
+ */
+class LogCensor
+{
+public:
+	/// set the strings to censor, mapped to what they should be replaced with
+	void setReplacements(const QMap<QString, QString> &replacements);
+
+	bool isEmpty() const
+	{
+		return m_patterns.isEmpty();
+	}
+
+	QString censor(const QString &in) const;
+
+private:
+	struct Node
+	{
+		QMap<ushort, int> next;
+		int fail = 0;
+		/// longest pattern ending at this node, -1 for none
+		int match = -1;
+	};
+	struct Pattern
+	{
+		QString text;
+		QString replacement;
+	};
+	int step(int state, ushort c) const;
+
+private:
+	QVector<Node> m_nodes;
+	QVector<Pattern> m_patterns;
+};
@@ -0,0 +1,64 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LogFilter.h"
+
+#include "logger/QsLog.h"
+
+void LogFilter::setMinimumLevel(MessageLevel::Enum level)
+{
+	m_minimumLevel = level;
+}
+
+bool LogFilter::setPattern(QRegularExpression &target, const QString &pattern)
+{
+	if (pattern.isEmpty())
+		return false;
+	QRegularExpression re(pattern);
+	if (!re.isValid())
+	{
+		QLOG_WARN() << "Ignoring invalid log filter" << pattern << ":" << re.errorString();
+		return false;
+	}
+	target = re;
+	return true;
+}
+
+bool LogFilter::setIncludePattern(const QString &pattern)
+{
+	m_hasInclude = setPattern(m_include, pattern);
+	return m_hasInclude || pattern.isEmpty();
+}
+
+bool LogFilter::setExcludePattern(const QString &pattern)
+{
+	m_hasExclude = setPattern(m_exclude, pattern);
+	return m_hasExclude || pattern.isEmpty();
+}
+
+bool LogFilter::accept(const QString &line, MessageLevel::Enum level)
+{
+	if (level == MessageLevel::MultiMC || level == MessageLevel::PrePost)
+		return true;
+
+	// cheapest check first
+	if (level < m_minimumLevel || (m_hasInclude && !m_include.match(line).hasMatch()) ||
+		(m_hasExclude && m_exclude.match(line).hasMatch()))
+	{
+		m_dropped++;
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,57 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <QRegularExpression>
+#include <QString>
+
+#include "MessageLevel.h"
+
+/**
+ * @brief Decides which lines of game output make it into the log
+ *
+ * Lines below the minimum level, lines that don't match the include pattern and lines that
+ * match the exclude pattern are dropped. Lines from MultiMC and the pre/post launch commands
+ * always pass. Empty patterns are not used.
+ */
+class LogFilter
+{
+public:
+	void setMinimumLevel(MessageLevel::Enum level);
+	/// returns false if the pattern isn't a valid regular expression. It is not used then.
+	bool setIncludePattern(const QString &pattern);
+	bool setExcludePattern(const QString &pattern);
+
+	/// should the line be kept? Counts the dropped ones.
+	bool accept(const QString &line, MessageLevel::Enum level);
+
+	/// number of lines dropped so far
+	int droppedLines() const
+	{
+		return m_dropped;
+	}
+
+private:
+	static bool setPattern(QRegularExpression &target, const QString &pattern);
+
+private:
+	MessageLevel::Enum m_minimumLevel = MessageLevel::MultiMC;
+	QRegularExpression m_include;
+	QRegularExpression m_exclude;
+	bool m_hasInclude = false;
+	bool m_hasExclude = false;
+	int m_dropped = 0;
+};
@@ -0,0 +1,212 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LogModel.h"
+
+#include <algorithm>
+
+LogModel::LogModel(QObject *parent) : QAbstractListModel(parent)
+{
+}
+
+int LogModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+		return 0;
+	return m_numLines;
+}
+
+QVariant LogModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid() || index.row() < 0 || index.row() >= m_numLines)
+		return QVariant();
+
+	switch (role)
+	{
+	case Qt::DisplayRole:
+		return line(index.row());
+	case LevelRole:
+		return level(index.row());
+	default:
+		return QVariant();
+	}
+}
+
+void LogModel::append(MessageLevel::Enum level, const QStringList &lines)
+{
+	if (lines.isEmpty())
+		return;
+
+	// of a batch bigger than the limit, only the tail survives anyway
+	int first = qMax(0, lines.size() - m_maxLines);
+	int count = lines.size() - first;
+
+	int overflow = m_numLines + count - m_maxLines;
+	if (overflow > 0)
+	{
+		beginRemoveRows(QModelIndex(), 0, overflow - 1);
+		m_firstLine = physicalRow(overflow);
+		m_numLines -= overflow;
+		m_firstSerial += overflow;
+		m_index.removeBefore(m_firstSerial);
+		endRemoveRows();
+	}
+
+	beginInsertRows(QModelIndex(), m_numLines, m_numLines + count - 1);
+	for (int i = first; i < lines.size(); i++)
+	{
+		Entry entry;
+		entry.text = lines[i].toUtf8();
+		entry.level = level;
+		m_index.addLine(m_firstSerial + m_numLines, entry.text, level);
+		// until the buffer is full, the next free slot is always at the end
+		int row = physicalRow(m_numLines);
+		if (row == m_content.size())
+			m_content.append(entry);
+		else
+			m_content[row] = entry;
+		m_numLines++;
+	}
+	endInsertRows();
+}
+
+void LogModel::clear()
+{
+	beginResetModel();
+	m_content.clear();
+	m_firstLine = 0;
+	m_numLines = 0;
+	m_firstSerial = 0;
+	m_index.clear();
+	endResetModel();
+}
+
+QString LogModel::line(int row) const
+{
+	return QString::fromUtf8(m_content[physicalRow(row)].text);
+}
+
+MessageLevel::Enum LogModel::level(int row) const
+{
+	return (MessageLevel::Enum)m_content[physicalRow(row)].level;
+}
+
+QString LogModel::toPlainText() const
+{
+	QByteArray out;
+	for (int i = 0; i < m_numLines; i++)
+	{
+		out.append(m_content[physicalRow(i)].text);
+		out.append('\n');
+	}
+	return QString::fromUtf8(out);
+}
+
+void LogModel::setMaxLines(int maxLines)
+{
+	maxLines = qMax(1, maxLines);
+	if (maxLines == m_maxLines)
+		return;
+
+	beginResetModel();
+	int keep = qMin(m_numLines, maxLines);
+	QVector<Entry> content;
+	content.reserve(keep);
+	for (int i = m_numLines - keep; i < m_numLines; i++)
+	{
+		content.append(m_content[physicalRow(i)]);
+	}
+	m_content = content;
+	m_firstLine = 0;
+	m_firstSerial += m_numLines - keep;
+	m_index.removeBefore(m_firstSerial);
+	m_numLines = keep;
+	m_maxLines = maxLines;
+	endResetModel();
+}
+
+bool LogModel::lineMatches(qint64 serial, const QByteArray &needle, quint32 levelMask) const
+{
+	const Entry &entry = m_content[physicalRow(serial - m_firstSerial)];
+	return (levelMask & (1u << entry.level)) && LogSearchIndex::contains(entry.text, needle);
+}
+
+int LogModel::find(const QString &text, int fromRow, bool backwards, quint32 levelMask) const
+{
+	if (text.isEmpty() || !m_numLines)
+		return -1;
+
+	const QByteArray needle = LogSearchIndex::prepareNeedle(text);
+	const auto blocks = m_index.candidateBlocks(needle, levelMask);
+	const qint64 lastSerial = m_firstSerial + m_numLines - 1;
+	const qint64 blockLines = LogSearchIndex::BLOCK_LINES;
+
+	if (!backwards)
+	{
+		const qint64 from = (fromRow < 0) ? m_firstSerial : m_firstSerial + fromRow + 1;
+		for (auto it = std::lower_bound(blocks.begin(), blocks.end(), from / blockLines);
+			 it != blocks.end(); ++it)
+		{
+			const qint64 begin = qMax(from, *it * blockLines);
+			const qint64 end = qMin(lastSerial, *it * blockLines + blockLines - 1);
+			for (qint64 serial = begin; serial <= end; serial++)
+			{
+				if (lineMatches(serial, needle, levelMask))
+					return serial - m_firstSerial;
+			}
+		}
+	}
+	else
+	{
+		const qint64 from = (fromRow < 0) ? lastSerial : m_firstSerial + fromRow - 1;
+		if (from < m_firstSerial)
+			return -1;
+		auto it = std::upper_bound(blocks.begin(), blocks.end(), from / blockLines);
+		while (it != blocks.begin())
+		{
+			--it;
+			const qint64 begin = qMax(m_firstSerial, *it * blockLines);
+			const qint64 end = qMin(from, *it * blockLines + blockLines - 1);
+			for (qint64 serial = end; serial >= begin; serial--)
+			{
+				if (lineMatches(serial, needle, levelMask))
+					return serial - m_firstSerial;
+			}
+		}
+	}
+	return -1;
+}
+
+int LogModel::countMatches(const QString &text, quint32 levelMask) const
+{
+	if (text.isEmpty() || !m_numLines)
+		return 0;
+
+	const QByteArray needle = LogSearchIndex::prepareNeedle(text);
+	const qint64 lastSerial = m_firstSerial + m_numLines - 1;
+	const qint64 blockLines = LogSearchIndex::BLOCK_LINES;
+	int count = 0;
+	for (qint64 block : m_index.candidateBlocks(needle, levelMask))
+	{
+		const qint64 begin = qMax(m_firstSerial, block * blockLines);
+		const qint64 end = qMin(lastSerial, block * blockLines + blockLines - 1);
+		for (qint64 serial = begin; serial <= end; serial++)
+		{
+			if (lineMatches(serial, needle, levelMask))
+				count++;
+		}
+	}
+	return count;
+}
@@ -0,0 +1,99 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QStringList>
+#include <QVector>
+
+#include "MessageLevel.h"
+#include "LogSearchIndex.h"
+
+/**
+ * A list model of log lines, backed by a ring buffer.
+ *
+ * Once the line limit is reached, the oldest lines are dropped as new ones come in.
+ * Lines are kept as UTF-8 and only turned into QStrings when something asks for them.
+ * They are also indexed as they come in, so searching doesn't have to look at every line.
+ */
+class LogModel : public QAbstractListModel
+{
+	Q_OBJECT
+public:
+	enum Roles
+	{
+		LevelRole = Qt::UserRole
+	};
+
+	explicit LogModel(QObject *parent = 0);
+
+	virtual int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	virtual QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+	/// append lines at the end, dropping the oldest lines if needed
+	void append(MessageLevel::Enum level, const QStringList &lines);
+
+	/// remove all lines
+	void clear();
+
+	QString line(int row) const;
+	MessageLevel::Enum level(int row) const;
+
+	/// all the lines, separated by newlines
+	QString toPlainText() const;
+
+	/// level mask for find() and countMatches() that includes all levels
+	static const quint32 AllLevels = 0xFFFFFFFF;
+
+	/**
+	 * @brief find the next line that contains some text (ASCII case insensitive)
+	 * @param fromRow the search starts after this row (before it when going backwards),
+	 *        -1 to search from the start (end)
+	 * @param levelMask bit (1 << level) set for each level to look at
+	 * @return the row, or -1 if there is none
+	 */
+	int find(const QString &text, int fromRow, bool backwards, quint32 levelMask = AllLevels) const;
+	/// number of lines that contain some text
+	int countMatches(const QString &text, quint32 levelMask = AllLevels) const;
+
+	int maxLines() const
+	{
+		return m_maxLines;
+	}
+	/// change the line limit. Drops the oldest lines if there are more than the new limit.
+	void setMaxLines(int maxLines);
+
+private:
+	struct Entry
+	{
+		QByteArray text;
+		quint8 level;
+	};
+	int physicalRow(int row) const
+	{
+		return (m_firstLine + row) % m_maxLines;
+	}
+	bool lineMatches(qint64 serial, const QByteArray &needle, quint32 levelMask) const;
+
+private:
+	QVector<Entry> m_content;
+	int m_maxLines = 100000;
+	int m_firstLine = 0;
+	int m_numLines = 0;
+	/// serial number of row 0, serials keep increasing for as long as the model lives
+	qint64 m_firstSerial = 0;
+	LogSearchIndex m_index;
+};
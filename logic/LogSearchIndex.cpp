@@ -0,0 +1,169 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LogSearchIndex.h"
+
+#include <algorithm>
+
+static inline char asciiLower(char c)
+{
+	return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+static inline quint32 trigramAt(const char *data)
+{
+	return (quint32(quint8(asciiLower(data[0]))) << 16) |
+		   (quint32(quint8(asciiLower(data[1]))) << 8) | quint32(quint8(asciiLower(data[2])));
+}
+
+void LogSearchIndex::addLine(qint64 serial, const QByteArray &utf8, int level)
+{
+	const qint64 block = serial / BLOCK_LINES;
+	if (m_blockLevels.isEmpty())
+	{
+		m_firstBlock = block;
+	}
+	while (m_firstBlock + m_blockLevels.size() <= block)
+	{
+		m_blockLevels.append(0);
+	}
+	m_blockLevels[block - m_firstBlock] |= (1u << level);
+
+	const char *data = utf8.constData();
+	for (int i = 0; i + 3 <= utf8.size(); i++)
+	{
+		// the block is only recorded once per trigram, no matter how often it shows up
+		auto &blocks = m_postings[trigramAt(data + i)];
+		if (blocks.isEmpty() || blocks.last() != block)
+			blocks.append(block);
+	}
+}
+
+void LogSearchIndex::removeBefore(qint64 serial)
+{
+	const qint64 block = serial / BLOCK_LINES;
+	if (block <= m_firstBlock)
+		return;
+
+	const int drop = qMin<qint64>(block - m_firstBlock, m_blockLevels.size());
+	m_blockLevels.remove(0, drop);
+	m_firstBlock = block;
+	m_droppedBlocks += drop;
+
+	// stale block numbers are skipped by searches, but shouldn't pile up forever
+	if (m_droppedBlocks > m_blockLevels.size())
+	{
+		compact();
+	}
+}
+
+void LogSearchIndex::compact()
+{
+	for (auto it = m_postings.begin(); it != m_postings.end();)
+	{
+		auto &blocks = it.value();
+		auto live = std::lower_bound(blocks.begin(), blocks.end(), m_firstBlock);
+		if (live == blocks.end())
+		{
+			it = m_postings.erase(it);
+			continue;
+		}
+		blocks.erase(blocks.begin(), live);
+		++it;
+	}
+	m_droppedBlocks = 0;
+}
+
+void LogSearchIndex::clear()
+{
+	m_postings.clear();
+	m_blockLevels.clear();
+	m_firstBlock = 0;
+	m_droppedBlocks = 0;
+}
+
+QVector<qint64> LogSearchIndex::candidateBlocks(const QByteArray &needle,
+												quint32 levelMask) const
+{
+	QVector<qint64> result;
+	auto levelsMatch = [&](qint64 block)
+	{ return (m_blockLevels[block - m_firstBlock] & levelMask) != 0; };
+
+	// too short for trigrams, every block is a candidate
+	if (needle.size() < 3)
+	{
+		for (qint64 block = m_firstBlock; block < m_firstBlock + m_blockLevels.size(); block++)
+		{
+			if (levelsMatch(block))
+				result.append(block);
+		}
+		return result;
+	}
+
+	// start from the rarest trigram, check the others by binary search
+	QVector<const QVector<qint64> *> lists;
+	for (int i = 0; i + 3 <= needle.size(); i++)
+	{
+		auto it = m_postings.constFind(trigramAt(needle.constData() + i));
+		if (it == m_postings.constEnd())
+			return result;
+		lists.append(&it.value());
+	}
+	std::sort(lists.begin(), lists.end(), [](const QVector<qint64> *a, const QVector<qint64> *b)
+			  { return a->size() < b->size(); });
+
+	const QVector<qint64> &rarest = *lists.first();
+	for (auto it = std::lower_bound(rarest.begin(), rarest.end(), m_firstBlock);
+		 it != rarest.end(); ++it)
+	{
+		const qint64 block = *it;
+		if (!levelsMatch(block))
+			continue;
+		bool inAll = true;
+		for (int i = 1; i < lists.size() && inAll; i++)
+		{
+			inAll = std::binary_search(lists[i]->begin(), lists[i]->end(), block);
+		}
+		if (inAll)
+			result.append(block);
+	}
+	return result;
+}
+
+QByteArray LogSearchIndex::prepareNeedle(const QString &text)
+{
+	QByteArray needle = text.toUtf8();
+	for (char &c : needle)
+	{
+		c = asciiLower(c);
+	}
+	return needle;
+}
+
+bool LogSearchIndex::contains(const QByteArray &line, const QByteArray &needle)
+{
+	const int length = needle.size();
+	const char *data = line.constData();
+	const char *pattern = needle.constData();
+	for (int pos = 0; pos + length <= line.size(); pos++)
+	{
+		int i = 0;
+		while (i < length && asciiLower(data[pos + i]) == pattern[i])
+			i++;
+		if (i == length)
+			return true;
+	}
+	return false;
+}
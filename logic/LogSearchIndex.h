@@ -0,0 +1,69 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+
+/**
+ * @brief A trigram index over a stream of log lines
+ *
+ * Lines are identified by serial numbers that keep increasing as lines come in. They are grouped
+ * into blocks of BLOCK_LINES lines, and for every trigram the index keeps the list of blocks that
+ * contain it. A search only has to look at the lines in the blocks that contain all the trigrams
+ * of the searched text.
+ *
+ * Matching is case insensitive for ASCII, everything else is compared byte by byte.
+ */
+class LogSearchIndex
+{
+public:
+	enum
+	{
+		BLOCK_LINES = 64
+	};
+
+	/// index a line. Serials have to be consecutive.
+	void addLine(qint64 serial, const QByteArray &utf8, int level);
+	/// forget everything about lines before the given serial
+	void removeBefore(qint64 serial);
+	void clear();
+
+	/**
+	 * @brief blocks that may contain the text and lines of one of the levels, in ascending order
+	 * @param needle the text as returned by prepareNeedle()
+	 * @param levelMask bit (1 << level) set for each level that should be included
+	 */
+	QVector<qint64> candidateBlocks(const QByteArray &needle, quint32 levelMask) const;
+
+	/// lower case UTF-8 of the text to search for
+	static QByteArray prepareNeedle(const QString &text);
+	/// does the line contain the needle?
+	static bool contains(const QByteArray &line, const QByteArray &needle);
+
+private:
+	void compact();
+
+private:
+	/// trigram -> ascending block numbers
+	QHash<quint32, QVector<qint64>> m_postings;
+	/// levels present in each block, starting at m_firstBlock
+	QVector<quint32> m_blockLevels;
+	qint64 m_firstBlock = 0;
+	/// blocks dropped since the postings were last cleaned up
+	qint64 m_droppedBlocks = 0;
+};
@@ -0,0 +1,147 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageLevel.h"
+
+#include <QRegularExpression>
+
+MessageLevel::Enum MessageLevel::getLevel(const QString &levelName)
+{
+	if (levelName == "MultiMC")
+		return MessageLevel::MultiMC;
+	else if (levelName == "Debug")
+		return MessageLevel::Debug;
+	else if (levelName == "Info")
+		return MessageLevel::Info;
+	else if (levelName == "Message")
+		return MessageLevel::Message;
+	else if (levelName == "Warning")
+		return MessageLevel::Warning;
+	else if (levelName == "Error")
+		return MessageLevel::Error;
+	else if (levelName == "Fatal")
+		return MessageLevel::Fatal;
+	// Skip PrePost, it's not exposed to !![]!
+	else
+		return MessageLevel::Message;
+}
+
+// Old style forge logs, tagged like [INFO]. When there are several tags, later ones in this
+// function win (a line with both [INFO] and [WARNING] is a warning).
+static MessageLevel::Enum guessLegacyLevel(const QString &line, MessageLevel::Enum level)
+{
+	int best = 0;
+	const int size = line.size();
+	for (int i = line.indexOf('['); i != -1; i = line.indexOf('[', i + 1))
+	{
+		// the longest tag is 7 characters
+		int end = i + 1;
+		while (end < size && end - i <= 8 && line[end] != ']')
+			end++;
+		if (end >= size || line[end] != ']')
+			continue;
+
+		QStringRef tag = line.midRef(i + 1, end - i - 1);
+		int rank = 0;
+		MessageLevel::Enum tagLevel = level;
+		if (tag == QLatin1String("INFO") || tag == QLatin1String("CONFIG") ||
+			tag == QLatin1String("FINE") || tag == QLatin1String("FINER") ||
+			tag == QLatin1String("FINEST"))
+		{
+			rank = 1;
+			tagLevel = MessageLevel::Message;
+		}
+		else if (tag == QLatin1String("SEVERE") || tag == QLatin1String("STDERR"))
+		{
+			rank = 2;
+			tagLevel = MessageLevel::Error;
+		}
+		else if (tag == QLatin1String("WARNING"))
+		{
+			rank = 3;
+			tagLevel = MessageLevel::Warning;
+		}
+		else if (tag == QLatin1String("DEBUG"))
+		{
+			rank = 4;
+			tagLevel = MessageLevel::Debug;
+		}
+		if (rank > best)
+		{
+			best = rank;
+			level = tagLevel;
+		}
+	}
+	return level;
+}
+
+// equivalent to matching "\s+at " - a line of a java stack trace
+static bool isStackTraceLine(const QString &line)
+{
+	for (int i = line.indexOf(QLatin1String("at "), 1); i != -1;
+		 i = line.indexOf(QLatin1String("at "), i + 1))
+	{
+		switch (line[i - 1].unicode())
+		{
+		case ' ':
+		case '\t':
+		case '\n':
+		case '\v':
+		case '\f':
+		case '\r':
+			return true;
+		default:
+			break;
+		}
+	}
+	return false;
+}
+
+MessageLevel::Enum MessageLevel::guessLevel(const QString &line, MessageLevel::Enum level)
+{
+	// this runs for every line of output, only compile it once
+	static const QRegularExpression log4jExp(
+		"\\[(?<timestamp>[0-9:]+)\\] \\[[^/]+/(?<level>[^\\]]+)\\]");
+
+	// both log styles need brackets, don't bother with the regex if there are none
+	if (line.contains('['))
+	{
+		auto match = log4jExp.match(line);
+		if (match.hasMatch())
+		{
+			// New style logs from log4j
+			QStringRef levelStr = match.capturedRef(2);
+			if (levelStr == QLatin1String("INFO"))
+				level = MessageLevel::Message;
+			else if (levelStr == QLatin1String("WARN"))
+				level = MessageLevel::Warning;
+			else if (levelStr == QLatin1String("ERROR"))
+				level = MessageLevel::Error;
+			else if (levelStr == QLatin1String("FATAL"))
+				level = MessageLevel::Fatal;
+			else if (levelStr == QLatin1String("TRACE") || levelStr == QLatin1String("DEBUG"))
+				level = MessageLevel::Debug;
+		}
+		else
+		{
+			level = guessLegacyLevel(line, level);
+		}
+	}
+	if (line.contains(QLatin1String("overwriting existing")))
+		return MessageLevel::Fatal;
+	if (line.contains(QLatin1String("Exception in thread")) || isStackTraceLine(line))
+		return MessageLevel::Error;
+	return level;
+}
@@ -0,0 +1,43 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <QString>
+
+/**
+ * @brief the MessageLevel Enum
+ * defines what level a message is
+ */
+namespace MessageLevel
+{
+enum Enum
+{
+	MultiMC, /**< MultiMC Messages */
+	Debug,   /**< Debug Messages */
+	Info,    /**< Info Messages */
+	Message, /**< Standard Messages */
+	Warning, /**< Warnings */
+	Error,   /**< Errors */
+	Fatal,   /**< Fatal Errors */
+	PrePost, /**< Pre/Post Launch command output */
+};
+
+/// the level with the given name, as used in the "!![Level]!" line prefix
+Enum getLevel(const QString &levelName);
+
+/// guess the level of a line of Minecraft output, starting from the given default
+Enum guessLevel(const QString &line, Enum level);
+}
@@ -20,10 +20,10 @@
 #include "MinecraftProcess.h"
 
 #include <QDataStream>
+#include <QDateTime>
 #include <QFile>
 #include <QDir>
 #include <QProcessEnvironment>
-#include <QRegularExpression>
 #include <QStandardPaths>
 
 #include "BaseInstance.h"
@@ -34,6 +34,11 @@
 
 #define IBUS "@im=ibus"
 
+// game output is handed to the UI in batches, at most this often...
+#define LOG_FLUSH_INTERVAL_MS 50
+// ... or as soon as this many lines pile up
+#define LOG_FLUSH_LINES 1000
+
 // constructor
 MinecraftProcess::MinecraftProcess(InstancePtr inst) : m_instance(inst)
 {
@@ -109,6 +114,21 @@ MinecraftProcess::MinecraftProcess(InstancePtr inst) : m_instance(inst)
 	connect(this, SIGNAL(readyReadStandardError()), SLOT(on_stdErr()));
 	connect(this, SIGNAL(readyReadStandardOutput()), SLOT(on_stdOut()));
 
+	// batched log delivery
+	m_logFlushTimer.setSingleShot(true);
+	m_logFlushTimer.setInterval(LOG_FLUSH_INTERVAL_MS);
+	connect(&m_logFlushTimer, SIGNAL(timeout()), SLOT(flushLog()));
+
+	// log filter rules
+	auto &settings = m_instance->settings();
+	m_filter.setMinimumLevel(MessageLevel::getLevel(settings.get("LogFilterMinLevel").toString()));
+	m_filter.setIncludePattern(settings.get("LogFilterInclude").toString());
+	m_filter.setExcludePattern(settings.get("LogFilterExclude").toString());
+
+	// resource usage
+	connect(&m_monitor, SIGNAL(sampled(ProcessResourceSample)),
+			SIGNAL(resourceUsage(ProcessResourceSample)));
+
 	// Log prepost launch command output (can be disabled.)
 	if (m_instance->settings().get("LogPrePostOutput").toBool())
 	{
@@ -129,88 +149,34 @@ void MinecraftProcess::setWorkdir(QString path)
 	m_prepostlaunchprocess.setWorkingDirectory(mcDir.absolutePath());
 }
 
-QString MinecraftProcess::censorPrivateInfo(QString in)
+void MinecraftProcess::setLogin(AuthSessionPtr session)
 {
-	if (!m_session)
-		return in;
-
-	if (m_session->session != "-")
-		in.replace(m_session->session, "<SESSION ID>");
-	in.replace(m_session->access_token, "<ACCESS TOKEN>");
-	in.replace(m_session->client_token, "<CLIENT TOKEN>");
-	in.replace(m_session->uuid, "<PROFILE ID>");
-	in.replace(m_session->player_name, "<PROFILE NAME>");
-
-	auto i = m_session->u.properties.begin();
-	while (i != m_session->u.properties.end())
-	{
-		in.replace(i.value(), "<" + i.key().toUpper() + ">");
-		++i;
-	}
+	m_session = session;
 
-	return in;
-}
-
-// console window
-MessageLevel::Enum MinecraftProcess::guessLevel(const QString &line, MessageLevel::Enum level)
-{
-	QRegularExpression re("\\[(?<timestamp>[0-9:]+)\\] \\[[^/]+/(?<level>[^\\]]+)\\]");
-	auto match = re.match(line);
-	if(match.hasMatch())
-	{
-		// New style logs from log4j
-		QString timestamp = match.captured("timestamp");
-		QString levelStr = match.captured("level");
-		if(levelStr == "INFO")
-			level = MessageLevel::Message;
-		if(levelStr == "WARN")
-			level = MessageLevel::Warning;
-		if(levelStr == "ERROR")
-			level = MessageLevel::Error;
-		if(levelStr == "FATAL")
-			level = MessageLevel::Fatal;
-		if(levelStr == "TRACE" || levelStr == "DEBUG")
-			level = MessageLevel::Debug;
-	}
-	else
+	// everything private that may show up in the log, censored in a single pass per line
+	QMap<QString, QString> replacements;
+	if (m_session)
 	{
-		// Old style forge logs
-		if (line.contains("[INFO]") || line.contains("[CONFIG]") || line.contains("[FINE]") ||
-			line.contains("[FINER]") || line.contains("[FINEST]"))
-			level = MessageLevel::Message;
-		if (line.contains("[SEVERE]") || line.contains("[STDERR]"))
-			level = MessageLevel::Error;
-		if (line.contains("[WARNING]"))
-			level = MessageLevel::Warning;
-		if (line.contains("[DEBUG]"))
-			level = MessageLevel::Debug;
+		if (m_session->session != "-")
+			replacements.insert(m_session->session, "<SESSION ID>");
+		replacements.insert(m_session->access_token, "<ACCESS TOKEN>");
+		replacements.insert(m_session->client_token, "<CLIENT TOKEN>");
+		replacements.insert(m_session->uuid, "<PROFILE ID>");
+		replacements.insert(m_session->player_name, "<PROFILE NAME>");
+
+		auto i = m_session->u.properties.begin();
+		while (i != m_session->u.properties.end())
+		{
+			replacements.insert(i.value(), "<" + i.key().toUpper() + ">");
+			++i;
+		}
 	}
-	if (line.contains("overwriting existing"))
-		return MessageLevel::Fatal;
-	if (line.contains("Exception in thread") || line.contains(QRegularExpression("\\s+at ")))
-		return MessageLevel::Error;
-	return level;
+	m_censor.setReplacements(replacements);
 }
 
-MessageLevel::Enum MinecraftProcess::getLevel(const QString &levelName)
+QString MinecraftProcess::censorPrivateInfo(const QString &in)
 {
-	if (levelName == "MultiMC")
-		return MessageLevel::MultiMC;
-	else if (levelName == "Debug")
-		return MessageLevel::Debug;
-	else if (levelName == "Info")
-		return MessageLevel::Info;
-	else if (levelName == "Message")
-		return MessageLevel::Message;
-	else if (levelName == "Warning")
-		return MessageLevel::Warning;
-	else if (levelName == "Error")
-		return MessageLevel::Error;
-	else if (levelName == "Fatal")
-		return MessageLevel::Fatal;
-	// Skip PrePost, it's not exposed to !![]!
-	else
-		return MessageLevel::Message;
+	return m_censor.censor(in);
 }
 
 void MinecraftProcess::logOutput(const QStringList &lines, MessageLevel::Enum defaultLevel,
@@ -225,27 +191,66 @@ void MinecraftProcess::logOutput(QString line, MessageLevel::Enum defaultLevel,
 {
 	MessageLevel::Enum level = defaultLevel;
 
-	//FIXME: make more flexible in the future
-	if(line.contains("ignoring option PermSize"))
-	{
-		return;
-	}
-
 	// Level prefix
 	int endmark = line.indexOf("]!");
 	if (line.startsWith("!![") && endmark != -1)
 	{
-		level = getLevel(line.left(endmark).mid(3));
+		level = MessageLevel::getLevel(line.mid(3, endmark - 3));
 		line = line.mid(endmark + 2);
 	}
 	// Guess level
 	else if (guessLevel)
-		level = this->guessLevel(line, defaultLevel);
+		level = MessageLevel::guessLevel(line, defaultLevel);
+
+	// drop unwanted lines before anything else is done with them
+	if (!m_filter.accept(line, level))
+		return;
 
 	if (censor)
 		line = censorPrivateInfo(line);
 
-	emit log(line, level);
+	queueLog(line, level);
+}
+
+void MinecraftProcess::queueLog(const QString &line, MessageLevel::Enum level)
+{
+	if (m_logQueue.isEmpty() || m_logQueue.last().first != level)
+	{
+		m_logQueue.append(qMakePair(level, QStringList()));
+	}
+	m_logQueue.last().second.append(line);
+	m_queuedLines++;
+
+	if (m_queuedLines >= LOG_FLUSH_LINES)
+	{
+		flushLog();
+	}
+	else if (!m_logFlushTimer.isActive())
+	{
+		m_logFlushTimer.start();
+	}
+}
+
+void MinecraftProcess::flushLog()
+{
+	m_logFlushTimer.stop();
+	auto queue = m_logQueue;
+	m_logQueue.clear();
+	m_queuedLines = 0;
+	for (auto &run : queue)
+	{
+		const QString text = run.second.join('\n');
+		m_sessionLog.write(text);
+		emit log(text, run.first);
+	}
+}
+
+void MinecraftProcess::emitLog(const QString &text, MessageLevel::Enum level)
+{
+	// keep the order of messages
+	flushLog();
+	m_sessionLog.write(text);
+	emit log(text, level);
 }
 
 void MinecraftProcess::on_stdErr()
@@ -299,6 +304,8 @@ void MinecraftProcess::on_prepost_stdOut()
 // exit handler
 void MinecraftProcess::finish(int code, ExitStatus status)
 {
+	m_monitor.stop();
+
 	// Flush console window
 	if (!m_err_leftover.isEmpty())
 	{
@@ -316,18 +323,18 @@ void MinecraftProcess::finish(int code, ExitStatus status)
 		if (status == NormalExit)
 		{
 			//: Message displayed on instance exit
-			emit log(tr("Minecraft exited with exitcode %1.").arg(code));
+			emitLog(tr("Minecraft exited with exitcode %1.").arg(code));
 		}
 		else
 		{
 			//: Message displayed on instance crashed
-			emit log(tr("Minecraft crashed with exitcode %1.").arg(code));
+			emitLog(tr("Minecraft crashed with exitcode %1.").arg(code));
 		}
 	}
 	else
 	{
 		//: Message displayed after the instance exits due to kill request
-		emit log(tr("Minecraft was killed by user."), MessageLevel::Error);
+		emitLog(tr("Minecraft was killed by user."), MessageLevel::Error);
 	}
 
 	m_prepostlaunchprocess.processEnvironment().insert("INST_EXITCODE", QString(code));
@@ -337,6 +344,8 @@ void MinecraftProcess::finish(int code, ExitStatus status)
 	m_instance->cleanupAfterRun();
 	// no longer running...
 	m_instance->setRunning(false);
+	flushLog();
+	m_sessionLog.close();
 	emit ended(m_instance, code, status);
 }
 
@@ -360,11 +369,11 @@ bool MinecraftProcess::preLaunch()
 	{
 		prelaunch_cmd = substituteVariables(prelaunch_cmd);
 		// Launch
-		emit log(tr("Running Pre-Launch command: %1").arg(prelaunch_cmd));
+		emitLog(tr("Running Pre-Launch command: %1").arg(prelaunch_cmd));
 		m_prepostlaunchprocess.start(prelaunch_cmd);
 		if (!waitForPrePost())
 		{
-			emit log(tr("The command failed to start"), MessageLevel::Fatal);
+			emitLog(tr("The command failed to start"), MessageLevel::Fatal);
 			return false;
 		}
 		// Flush console window
@@ -381,9 +390,9 @@ bool MinecraftProcess::preLaunch()
 		// Process return values
 		if (m_prepostlaunchprocess.exitStatus() != NormalExit)
 		{
-			emit log(tr("Pre-Launch command failed with code %1.\n\n")
-						 .arg(m_prepostlaunchprocess.exitCode()),
-					 MessageLevel::Fatal);
+			emitLog(tr("Pre-Launch command failed with code %1.\n\n")
+						.arg(m_prepostlaunchprocess.exitCode()),
+					MessageLevel::Fatal);
 			m_instance->cleanupAfterRun();
 			emit prelaunch_failed(m_instance, m_prepostlaunchprocess.exitCode(),
 								  m_prepostlaunchprocess.exitStatus());
@@ -392,7 +401,7 @@ bool MinecraftProcess::preLaunch()
 			return false;
 		}
 		else
-			emit log(tr("Pre-Launch command ran successfully.\n\n"));
+			emitLog(tr("Pre-Launch command ran successfully.\n\n"));
 
 		return m_instance->reload();
 	}
@@ -404,7 +413,7 @@ bool MinecraftProcess::postLaunch()
 	if (!postlaunch_cmd.isEmpty())
 	{
 		postlaunch_cmd = substituteVariables(postlaunch_cmd);
-		emit log(tr("Running Post-Launch command: %1").arg(postlaunch_cmd));
+		emitLog(tr("Running Post-Launch command: %1").arg(postlaunch_cmd));
 		m_prepostlaunchprocess.start(postlaunch_cmd);
 		if (!waitForPrePost())
 		{
@@ -423,16 +432,16 @@ bool MinecraftProcess::postLaunch()
 		}
 		if (m_prepostlaunchprocess.exitStatus() != NormalExit)
 		{
-			emit log(tr("Post-Launch command failed with code %1.\n\n")
-						 .arg(m_prepostlaunchprocess.exitCode()),
-					 MessageLevel::Error);
+			emitLog(tr("Post-Launch command failed with code %1.\n\n")
+						.arg(m_prepostlaunchprocess.exitCode()),
+					MessageLevel::Error);
 			emit postlaunch_failed(m_instance, m_prepostlaunchprocess.exitCode(),
 								   m_prepostlaunchprocess.exitStatus());
 			// not running, failed
 			m_instance->setRunning(false);
 		}
 		else
-			emit log(tr("Post-Launch command ran successfully.\n\n"));
+			emitLog(tr("Post-Launch command ran successfully.\n\n"));
 
 		return m_instance->reload();
 	}
@@ -520,8 +529,13 @@ QStringList MinecraftProcess::javaArguments() const
 
 void MinecraftProcess::arm()
 {
-	emit log("MultiMC version: " + BuildConfig.printableVersionString() + "\n\n");
-	emit log("Minecraft folder is:\n" + workingDirectory() + "\n\n");
+	// the session log and resource usage record go next to each other
+	const QString logFolder = PathCombine(m_instance->instanceRoot(), "multimc-logs");
+	const QString sessionTime = QDateTime::currentDateTime().toString("yyyy-MM-dd_HH-mm-ss");
+	m_sessionLog.open(logFolder, "session-" + sessionTime);
+
+	emitLog("MultiMC version: " + BuildConfig.printableVersionString() + "\n\n");
+	emitLog("Minecraft folder is:\n" + workingDirectory() + "\n\n");
 
 	if (!preLaunch())
 	{
@@ -534,16 +548,16 @@ void MinecraftProcess::arm()
 	QStringList args = javaArguments();
 
 	QString JavaPath = m_instance->settings().get("JavaPath").toString();
-	emit log("Java path is:\n" + JavaPath + "\n\n");
+	emitLog("Java path is:\n" + JavaPath + "\n\n");
 	QString allArgs = args.join(", ");
-	emit log("Java Arguments:\n[" + censorPrivateInfo(allArgs) + "]\n\n");
+	emitLog("Java Arguments:\n[" + censorPrivateInfo(allArgs) + "]\n\n");
 
 	auto realJavaPath = QStandardPaths::findExecutable(JavaPath);
 	if (realJavaPath.isEmpty())
 	{
-		emit log(tr("The java binary \"%1\" couldn't be found. You may have to set up java "
-					"if Minecraft fails to launch.").arg(JavaPath),
-				 MessageLevel::Warning);
+		emitLog(tr("The java binary \"%1\" couldn't be found. You may have to set up java "
+				   "if Minecraft fails to launch.").arg(JavaPath),
+				MessageLevel::Warning);
 	}
 
 	// instantiate the launcher part
@@ -551,13 +565,19 @@ void MinecraftProcess::arm()
 	if (!waitForStarted())
 	{
 		//: Error message displayed if instace can't start
-		emit log(tr("Could not launch minecraft!"), MessageLevel::Error);
+		emitLog(tr("Could not launch minecraft!"), MessageLevel::Error);
 		m_instance->cleanupAfterRun();
 		emit launch_failed(m_instance);
 		// not running, failed
 		m_instance->setRunning(false);
 		return;
 	}
+
+	// keep an eye on the resource usage of the game and record it next to the logs
+#ifdef Q_OS_LINUX
+	m_monitor.start(pid(), PathCombine(logFolder, QString("resources-%1.csv").arg(sessionTime)));
+#endif
+
 	// send the launch script to the launcher part
 	QByteArray bytes = launchScript.toUtf8();
 	writeData(bytes.constData(), bytes.length());
@@ -19,26 +19,13 @@
 
 #include <QProcess>
 #include <QString>
+#include <QTimer>
 #include "BaseInstance.h"
-
-/**
- * @brief the MessageLevel Enum
- * defines what level a message is
- */
-namespace MessageLevel
-{
-enum Enum
-{
-	MultiMC, /**< MultiMC Messages */
-	Debug,   /**< Debug Messages */
-	Info,    /**< Info Messages */
-	Message, /**< Standard Messages */
-	Warning, /**< Warnings */
-	Error,   /**< Errors */
-	Fatal,   /**< Fatal Errors */
-	PrePost, /**< Pre/Post Launch command output */
-};
-}
+#include "MessageLevel.h"
+#include "ProcessMonitor.h"
+#include "LogCensor.h"
+#include "LogFilter.h"
+#include "SessionLogWriter.h"
 
 /**
  * @file data/minecraftprocess.h
@@ -93,9 +80,12 @@ public:
 
 	void killMinecraft();
 
-	inline void setLogin(AuthSessionPtr session)
+	void setLogin(AuthSessionPtr session);
+
+	/// number of lines of output dropped by the log filter rules
+	int droppedLines() const
 	{
-		m_session = session;
+		return m_filter.droppedLines();
 	}
 
 signals:
@@ -126,6 +116,11 @@ signals:
 	 */
 	void log(QString text, MessageLevel::Enum level = MessageLevel::MultiMC);
 
+	/**
+	 * @brief emitted periodically with the resource usage of the running game
+	 */
+	void resourceUsage(ProcessResourceSample sample);
+
 protected:
 	InstancePtr m_instance;
 	QString m_err_leftover;
@@ -133,8 +128,18 @@ protected:
 	QProcess m_prepostlaunchprocess;
 	bool killed = false;
 	AuthSessionPtr m_session;
+	LogCensor m_censor;
+	LogFilter m_filter;
 	QString launchScript;
 	QString m_nativeFolder;
+	ProcessMonitor m_monitor;
+
+	/// game output waiting to be delivered, as runs of lines with the same level
+	QList<QPair<MessageLevel::Enum, QStringList>> m_logQueue;
+	int m_queuedLines = 0;
+	QTimer m_logFlushTimer;
+	/// everything that goes to the console also goes here
+	SessionLogWriter m_sessionLog;
 
 	bool preLaunch();
 	bool postLaunch();
@@ -151,6 +156,7 @@ slots:
 	void on_stdOut();
 	void on_prepost_stdOut();
 	void on_prepost_stdErr();
+	void flushLog();
 	void logOutput(const QStringList &lines,
 				   MessageLevel::Enum defaultLevel = MessageLevel::Message,
 				   bool guessLevel = true, bool censor = true);
@@ -159,7 +165,7 @@ slots:
 				   bool guessLevel = true, bool censor = true);
 
 private:
-	QString censorPrivateInfo(QString in);
-	MessageLevel::Enum guessLevel(const QString &message, MessageLevel::Enum defaultLevel);
-	MessageLevel::Enum getLevel(const QString &levelName);
+	void queueLog(const QString &line, MessageLevel::Enum level);
+	void emitLog(const QString &text, MessageLevel::Enum level = MessageLevel::MultiMC);
+	QString censorPrivateInfo(const QString &in);
 };
@@ -206,7 +206,7 @@ void OneSixUpdate::jarlibStart()
 	}
 
 	auto libs = version->getActiveNativeLibs();
-	libs.append(version->getActiveNormalLibs());
+	libs += version->getActiveNormalLibs();
 
 	auto metacache = MMC->metacache();
 	QList<ForgeXzDownloadPtr> ForgeLibs;
@@ -0,0 +1,199 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ProcessMonitor.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+
+#include "logger/QsLog.h"
+#include "pathutils.h"
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+// sampling is cheap, but there is no point in doing it more often
+#define SAMPLE_INTERVAL_MS 5000
+// how long resource usage records are kept, in days. Same as the session logs.
+#define MAX_AGE_DAYS 30
+// how many resource usage records are kept at most
+#define MAX_FILES 50
+
+ProcessMonitor::ProcessMonitor(QObject *parent) : QObject(parent)
+{
+	qRegisterMetaType<ProcessResourceSample>("ProcessResourceSample");
+	m_timer.setInterval(SAMPLE_INTERVAL_MS);
+	connect(&m_timer, SIGNAL(timeout()), SLOT(sample()));
+}
+
+ProcessMonitor::~ProcessMonitor()
+{
+	stop();
+}
+
+bool ProcessMonitor::isSupported()
+{
+#ifdef Q_OS_LINUX
+	return true;
+#else
+	return false;
+#endif
+}
+
+void ProcessMonitor::start(qint64 pid, const QString &recordPath)
+{
+	stop();
+	if (!isSupported() || pid <= 0)
+		return;
+
+	m_pid = pid;
+	m_hasLast = false;
+
+	if (!recordPath.isEmpty())
+	{
+		prune(QFileInfo(recordPath).absolutePath());
+		m_record.setFileName(recordPath);
+		if (!ensureFilePathExists(recordPath) ||
+			!m_record.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+		{
+			QLOG_WARN() << "Couldn't open resource usage record" << recordPath << ":"
+						<< m_record.errorString();
+		}
+		else if (m_record.size() == 0)
+		{
+			m_record.write("timestamp,rss,cputime,threads,read,written\n");
+		}
+	}
+
+	sample();
+	m_timer.start();
+}
+
+void ProcessMonitor::prune(const QString &folder)
+{
+	QDir dir(folder);
+	auto files = dir.entryInfoList(QStringList() << "resources-*.csv", QDir::Files, QDir::Time);
+	const QDateTime cutoff = QDateTime::currentDateTime().addDays(-MAX_AGE_DAYS);
+	for (int i = 0; i < files.size(); i++)
+	{
+		// newest first
+		if (i >= MAX_FILES || files[i].lastModified() < cutoff)
+		{
+			if (!QFile::remove(files[i].absoluteFilePath()))
+			{
+				QLOG_WARN() << "Couldn't remove old resource usage record"
+							<< files[i].absoluteFilePath();
+			}
+		}
+	}
+}
+
+void ProcessMonitor::stop()
+{
+	m_timer.stop();
+	if (m_record.isOpen())
+	{
+		m_record.close();
+	}
+	m_pid = 0;
+}
+
+void ProcessMonitor::sample()
+{
+	ProcessResourceSample current;
+	if (!readSample(current))
+	{
+		// the process is gone.
+		stop();
+		return;
+	}
+
+	if (m_hasLast)
+	{
+		qint64 elapsed = current.timestamp - m_last.timestamp;
+		if (elapsed > 0)
+		{
+			current.cpuUsage = 100.0 * (current.cpuTime - m_last.cpuTime) / elapsed;
+		}
+	}
+	m_last = current;
+	m_hasLast = true;
+
+	if (m_record.isOpen())
+	{
+		m_record.write(QString("%1,%2,%3,%4,%5,%6\n")
+						   .arg(current.timestamp)
+						   .arg(current.residentBytes)
+						   .arg(current.cpuTime)
+						   .arg(current.threads)
+						   .arg(current.readBytes)
+						   .arg(current.writtenBytes)
+						   .toLatin1());
+		m_record.flush();
+	}
+
+	emit sampled(current);
+}
+
+bool ProcessMonitor::readSample(ProcessResourceSample &out) const
+{
+#ifdef Q_OS_LINUX
+	const QString procDir = QString("/proc/%1").arg(m_pid);
+
+	QFile statFile(procDir + "/stat");
+	if (!statFile.open(QIODevice::ReadOnly))
+		return false;
+	const QByteArray stat = statFile.readAll();
+
+	// the command name may contain spaces and parens, so skip past the last paren
+	int commEnd = stat.lastIndexOf(')');
+	if (commEnd == -1)
+		return false;
+	const QList<QByteArray> fields = stat.mid(commEnd + 2).split(' ');
+	// fields are counted from 'state', which is field 3 in proc(5)
+	if (fields.size() < 22)
+		return false;
+
+	static const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+	static const long pageSize = sysconf(_SC_PAGESIZE);
+
+	const qint64 utime = fields[11].toLongLong();
+	const qint64 stime = fields[12].toLongLong();
+	out.cpuTime = (utime + stime) * 1000 / ticksPerSecond;
+	out.threads = fields[17].toInt();
+	out.residentBytes = fields[21].toLongLong() * pageSize;
+
+	// I/O accounting may be unavailable (kernel config, permissions), don't fail on it
+	QFile ioFile(procDir + "/io");
+	if (ioFile.open(QIODevice::ReadOnly))
+	{
+		for (const QByteArray &line : ioFile.readAll().split('\n'))
+		{
+			if (line.startsWith("read_bytes:"))
+				out.readBytes = line.mid(11).trimmed().toLongLong();
+			else if (line.startsWith("write_bytes:"))
+				out.writtenBytes = line.mid(12).trimmed().toLongLong();
+		}
+	}
+
+	out.timestamp = QDateTime::currentMSecsSinceEpoch();
+	return true;
+#else
+	Q_UNUSED(out);
+	return false;
+#endif
+}
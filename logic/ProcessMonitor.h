@@ -0,0 +1,104 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QFile>
+#include <QMetaType>
+
+/**
+ * @brief One resource usage sample of a running process
+ */
+struct ProcessResourceSample
+{
+	/// when the sample was taken, in msecs since epoch
+	qint64 timestamp = 0;
+	/// resident set size, in bytes
+	qint64 residentBytes = 0;
+	/// user + system CPU time, in msecs
+	qint64 cpuTime = 0;
+	/// CPU usage since the previous sample, in percent of one core
+	double cpuUsage = 0.0;
+	/// number of threads
+	int threads = 0;
+	/// bytes read from and written to storage
+	qint64 readBytes = 0;
+	qint64 writtenBytes = 0;
+};
+Q_DECLARE_METATYPE(ProcessResourceSample)
+
+/**
+ * @brief Periodically samples the resource usage of a process
+ *
+ * Samples are emitted as signals and optionally appended to a CSV time series.
+ * Only Linux (/proc) is supported, elsewhere this does nothing.
+ */
+class ProcessMonitor : public QObject
+{
+	Q_OBJECT
+public:
+	explicit ProcessMonitor(QObject *parent = 0);
+	virtual ~ProcessMonitor();
+
+	/// can processes be sampled on this platform?
+	static bool isSupported();
+
+	/**
+	 * @brief start sampling a process
+	 * @param pid the process to sample
+	 * @param recordPath file to record the time series in. Empty to not record anything.
+	 *        Old records (resources-*.csv) next to it are removed.
+	 */
+	void start(qint64 pid, const QString &recordPath = QString());
+
+	/// remove old resource usage records from a folder
+	static void prune(const QString &folder);
+
+	/// stop sampling and close the time series
+	void stop();
+
+	bool isActive() const
+	{
+		return m_timer.isActive();
+	}
+
+	void setInterval(int msec)
+	{
+		m_timer.setInterval(msec);
+	}
+
+	ProcessResourceSample lastSample() const
+	{
+		return m_last;
+	}
+
+signals:
+	void sampled(ProcessResourceSample sample);
+
+private slots:
+	void sample();
+
+private:
+	bool readSample(ProcessResourceSample &out) const;
+
+private:
+	QTimer m_timer;
+	qint64 m_pid = 0;
+	QFile m_record;
+	ProcessResourceSample m_last;
+	bool m_hasLast = false;
+};
@@ -1,60 +1,204 @@
 #pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <list>
+
+/**
+ * A thread safe key-value cache.
+ *
+ * The keys are spread over a number of shards, each with its own lock, so threads working on
+ * different keys rarely wait for each other.
+ *
+ * It can be bounded by the number of entries, by their total cost (bytes of pixmap, for
+ * example), or both. When it's over a limit, the least recently used entries are dropped.
+ * The limits are split evenly between the shards, so they hold for the whole cache only
+ * roughly. A limit of 0 means no limit.
+ */
 template <typename K, typename V>
 class RWStorage
 {
 public:
-	void add(K key, V value)
+	struct Stats
 	{
-		QWriteLocker l(&lock);
-		cache[key] = value;
-		stale_entries.remove(key);
+		int entries = 0;
+		qint64 cost = 0;
+		quint64 hits = 0;
+		quint64 misses = 0;
+		quint64 evictions = 0;
+	};
+
+	explicit RWStorage(int maxEntries = 0, qint64 maxCost = 0)
+	{
+		setLimits(maxEntries, maxCost);
 	}
-	V get(K key)
+
+	void setLimits(int maxEntries, qint64 maxCost)
 	{
-		QReadLocker l(&lock);
-		if(cache.contains(key))
+		for (auto &shard : m_shards)
 		{
-			return cache[key];
+			QMutexLocker l(&shard.lock);
+			shard.maxEntries = maxEntries ? qMax(1, (maxEntries + SHARDS - 1) / SHARDS) : 0;
+			shard.maxCost = maxCost ? qMax<qint64>(1, (maxCost + SHARDS - 1) / SHARDS) : 0;
+			shard.trim();
 		}
-		else return V();
 	}
-	bool get(K key, V& value)
+
+	void add(K key, V value, qint64 cost = 1)
 	{
-		QReadLocker l(&lock);
-		if(cache.contains(key))
+		Shard &shard = shardFor(key);
+		QMutexLocker l(&shard.lock);
+		auto it = shard.entries.find(key);
+		if (it != shard.entries.end())
 		{
-			value = cache[key];
-			return true;
+			shard.cost -= it->cost;
+			shard.order.erase(it->position);
+			shard.entries.erase(it);
+		}
+		Entry entry;
+		entry.value = value;
+		entry.cost = cost;
+		entry.position = shard.order.insert(shard.order.end(), key);
+		shard.entries.insert(key, entry);
+		shard.cost += cost;
+		shard.trim();
+	}
+	V get(K key)
+	{
+		V value;
+		get(key, value);
+		return value;
+	}
+	bool get(K key, V &value)
+	{
+		Shard &shard = shardFor(key);
+		QMutexLocker l(&shard.lock);
+		auto it = shard.entries.find(key);
+		if (it == shard.entries.end())
+		{
+			shard.misses++;
+			return false;
 		}
-		else return false;
+		shard.hits++;
+		shard.touch(*it);
+		value = it->value;
+		return true;
 	}
 	bool has(K key)
 	{
-		QReadLocker l(&lock);
-		return cache.contains(key);
+		Shard &shard = shardFor(key);
+		QMutexLocker l(&shard.lock);
+		return shard.entries.contains(key);
 	}
+	bool remove(K key)
+	{
+		Shard &shard = shardFor(key);
+		QMutexLocker l(&shard.lock);
+		auto it = shard.entries.find(key);
+		if (it == shard.entries.end())
+			return false;
+		shard.cost -= it->cost;
+		shard.order.erase(it->position);
+		shard.entries.erase(it);
+		return true;
+	}
+	/// true if there is no entry for the key, or it was marked stale
 	bool stale(K key)
 	{
-		QReadLocker l(&lock);
-		if(!cache.contains(key))
+		Shard &shard = shardFor(key);
+		QMutexLocker l(&shard.lock);
+		auto it = shard.entries.find(key);
+		if (it == shard.entries.end())
 			return true;
-		return stale_entries.contains(key);
+		return it->stale;
 	}
+	/// mark an entry as outdated. It can still be read until it's replaced.
 	void setStale(K key)
 	{
-		QReadLocker l(&lock);
-		if(cache.contains(key))
+		Shard &shard = shardFor(key);
+		QMutexLocker l(&shard.lock);
+		auto it = shard.entries.find(key);
+		if (it != shard.entries.end())
 		{
-			stale_entries.insert(key);
+			it->stale = true;
 		}
 	}
 	void clear()
 	{
-		QWriteLocker l(&lock);
-		cache.clear();
+		for (auto &shard : m_shards)
+		{
+			QMutexLocker l(&shard.lock);
+			shard.entries.clear();
+			shard.order.clear();
+			shard.cost = 0;
+		}
+	}
+	Stats stats()
+	{
+		Stats result;
+		for (auto &shard : m_shards)
+		{
+			QMutexLocker l(&shard.lock);
+			result.entries += shard.entries.size();
+			result.cost += shard.cost;
+			result.hits += shard.hits;
+			result.misses += shard.misses;
+			result.evictions += shard.evictions;
+		}
+		return result;
+	}
+
+private:
+	enum
+	{
+		SHARDS = 16
+	};
+	struct Entry
+	{
+		V value;
+		qint64 cost = 0;
+		bool stale = false;
+		/// where the key is in the LRU order of the shard
+		typename std::list<K>::iterator position;
+	};
+	struct Shard
+	{
+		QMutex lock;
+		QHash<K, Entry> entries;
+		/// least recently used first
+		std::list<K> order;
+		qint64 cost = 0;
+		int maxEntries = 0;
+		qint64 maxCost = 0;
+		quint64 hits = 0;
+		quint64 misses = 0;
+		quint64 evictions = 0;
+
+		void touch(Entry &entry)
+		{
+			order.splice(order.end(), order, entry.position);
+		}
+		void trim()
+		{
+			// the newest entry always stays, even if it alone is over the limit
+			while (order.size() > 1 && ((maxEntries && entries.size() > maxEntries) ||
+										(maxCost && cost > maxCost)))
+			{
+				auto it = entries.find(order.front());
+				cost -= it->cost;
+				entries.erase(it);
+				order.pop_front();
+				evictions++;
+			}
+		}
+	};
+	Shard &shardFor(const K &key)
+	{
+		return m_shards[qHash(key) % SHARDS];
 	}
+
 private:
-	QReadWriteLock lock;
-	QMap<K, V> cache;
-	QSet<K> stale_entries;
-};
\ No newline at end of file
+	Shard m_shards[SHARDS];
+};
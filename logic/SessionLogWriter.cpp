@@ -0,0 +1,156 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SessionLogWriter.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QtConcurrentRun>
+
+#include <quagzipfile.h>
+
+#include "logger/QsLog.h"
+#include "pathutils.h"
+
+// uncompressed size after which a session continues in a new file
+#define MAX_PART_SIZE (64 * 1024 * 1024)
+// how long session logs are kept, in days
+#define MAX_AGE_DAYS 30
+// how many session logs are kept at most
+#define MAX_FILES 50
+// text is handed to the worker thread in chunks of about this many bytes
+#define CHUNK_SIZE (64 * 1024)
+
+SessionLogWriter::SessionLogWriter()
+{
+}
+
+SessionLogWriter::~SessionLogWriter()
+{
+	close();
+}
+
+bool SessionLogWriter::open(const QString &folder, const QString &name)
+{
+	close();
+	if (!ensureFolderPathExists(folder))
+	{
+		QLOG_WARN() << "Couldn't create session log folder" << folder;
+		return false;
+	}
+	prune(folder);
+
+	m_folder = folder;
+	m_name = name;
+	m_part = 1;
+	m_open = openPart();
+	return m_open;
+}
+
+bool SessionLogWriter::openPart()
+{
+	QString fileName = m_part == 1 ? QString("%1.log.gz").arg(m_name)
+								   : QString("%1-%2.log.gz").arg(m_name).arg(m_part);
+	m_file.reset(new QuaGzipFile(PathCombine(m_folder, fileName)));
+	m_written = 0;
+	if (!m_file->open(QIODevice::WriteOnly))
+	{
+		QLOG_WARN() << "Couldn't open session log" << m_file->getFileName() << ":"
+					<< m_file->errorString();
+		m_file.reset();
+		return false;
+	}
+	return true;
+}
+
+void SessionLogWriter::closePart()
+{
+	if (m_file)
+	{
+		m_file->close();
+		m_file.reset();
+	}
+}
+
+void SessionLogWriter::close()
+{
+	flush();
+	m_writer.waitForFinished();
+	closePart();
+	m_open = false;
+}
+
+bool SessionLogWriter::isOpen() const
+{
+	return m_open;
+}
+
+void SessionLogWriter::write(const QString &text)
+{
+	if (!m_open)
+		return;
+
+	m_buffer.append(text.toUtf8());
+	if (!m_buffer.endsWith('\n'))
+		m_buffer.append('\n');
+	if (m_buffer.size() >= CHUNK_SIZE)
+		flush();
+}
+
+void SessionLogWriter::flush()
+{
+	if (m_buffer.isEmpty())
+		return;
+	// usually long done by the time the next chunk is ready
+	m_writer.waitForFinished();
+	m_writer = QtConcurrent::run(this, &SessionLogWriter::writeChunk, m_buffer);
+	m_buffer.clear();
+}
+
+void SessionLogWriter::writeChunk(QByteArray data)
+{
+	// opening the next part failed
+	if (!m_file)
+		return;
+
+	m_file->write(data);
+	m_written += data.size();
+
+	// chunks are whole lines, so parts still start at the beginning of a line
+	if (m_written >= MAX_PART_SIZE)
+	{
+		closePart();
+		m_part++;
+		openPart();
+	}
+}
+
+void SessionLogWriter::prune(const QString &folder)
+{
+	QDir dir(folder);
+	auto files = dir.entryInfoList(QStringList() << "*.log.gz", QDir::Files, QDir::Time);
+	const QDateTime cutoff = QDateTime::currentDateTime().addDays(-MAX_AGE_DAYS);
+	for (int i = 0; i < files.size(); i++)
+	{
+		// newest first
+		if (i >= MAX_FILES || files[i].lastModified() < cutoff)
+		{
+			if (!QFile::remove(files[i].absoluteFilePath()))
+			{
+				QLOG_WARN() << "Couldn't remove old session log" << files[i].absoluteFilePath();
+			}
+		}
+	}
+}
@@ -0,0 +1,74 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <QString>
+#include <QByteArray>
+#include <QFuture>
+#include <QScopedPointer>
+
+class QuaGzipFile;
+
+/**
+ * @brief Writes the output of a game session into gzip compressed files
+ *
+ * Each session goes to <folder>/<name>.log.gz. When a file gets too big, the session continues
+ * in <name>-2.log.gz and so on. Session logs older than a month are removed, and only the most
+ * recent ones are kept.
+ *
+ * Text is collected in memory and compressed and written in a worker thread, one chunk at a
+ * time, so the GUI thread never waits for zlib.
+ */
+class SessionLogWriter
+{
+public:
+	SessionLogWriter();
+	~SessionLogWriter();
+
+	/// start writing a new session. Closes the current one first.
+	bool open(const QString &folder, const QString &name);
+	void close();
+	bool isOpen() const;
+
+	/// append text, ending it with a newline if it doesn't have one
+	void write(const QString &text);
+	/// hand everything written so far to the worker thread
+	void flush();
+
+	/// remove old session logs from a folder
+	static void prune(const QString &folder);
+
+private:
+	bool openPart();
+	void closePart();
+	/// runs in the worker thread
+	void writeChunk(QByteArray data);
+
+private:
+	/// text not handed to the worker yet
+	QByteArray m_buffer;
+	/// the chunk being written. Only one is written at a time, so they stay in order.
+	QFuture<void> m_writer;
+	bool m_open = false;
+
+	// only used by the worker while the log is open
+	QScopedPointer<QuaGzipFile> m_file;
+	QString m_folder;
+	QString m_name;
+	int m_part = 0;
+	/// uncompressed bytes written to the current part
+	qint64 m_written = 0;
+};
@@ -0,0 +1,92 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StringPool.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+namespace
+{
+struct Pool
+{
+	QMutex mutex;
+	QSet<QString> strings;
+	StringPool::Stats stats;
+};
+
+Pool &pool()
+{
+	static Pool instance;
+	return instance;
+}
+}
+
+QString StringPool::intern(const QString &str)
+{
+	// not worth a lookup, empty strings share their data anyway
+	if (str.isEmpty())
+		return str;
+
+	Pool &p = pool();
+	QMutexLocker locker(&p.mutex);
+	p.stats.lookups++;
+	auto it = p.strings.constFind(str);
+	if (it != p.strings.constEnd())
+	{
+		p.stats.hits++;
+		// only a separate copy that nobody else holds is really freed by using the pooled one
+		if (it->constData() != str.constData() && str.isDetached())
+		{
+			p.stats.savedBytes += str.size() * sizeof(QChar);
+		}
+		return *it;
+	}
+	p.strings.insert(str);
+	p.stats.strings++;
+	p.stats.bytes += str.size() * sizeof(QChar);
+	return str;
+}
+
+int StringPool::prune()
+{
+	Pool &p = pool();
+	QMutexLocker locker(&p.mutex);
+	int dropped = 0;
+	for (auto it = p.strings.begin(); it != p.strings.end();)
+	{
+		// detached means the pool holds the only reference
+		if (it->isDetached())
+		{
+			p.stats.strings--;
+			p.stats.bytes -= it->size() * sizeof(QChar);
+			it = p.strings.erase(it);
+			dropped++;
+		}
+		else
+		{
+			++it;
+		}
+	}
+	return dropped;
+}
+
+StringPool::Stats StringPool::stats()
+{
+	Pool &p = pool();
+	QMutexLocker locker(&p.mutex);
+	return p.stats;
+}
@@ -0,0 +1,55 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <QString>
+
+/**
+ * A process wide pool of strings.
+ *
+ * Most instances are built from the same few version files, so the same library coordinates,
+ * URLs and paths would otherwise be in memory once per instance. intern() hands out one
+ * implicitly shared copy of each instead. QString is copy-on-write, so nobody can change the
+ * pooled copy behind the back of everyone else using it.
+ *
+ * All of it is thread safe.
+ */
+class StringPool
+{
+public:
+	struct Stats
+	{
+		/// distinct strings in the pool
+		int strings = 0;
+		/// memory used by the characters of those strings
+		qint64 bytes = 0;
+		/// number of intern() calls
+		qint64 lookups = 0;
+		/// number of intern() calls that found the string already pooled
+		qint64 hits = 0;
+		/// memory of the duplicate copies that were replaced by the pooled one and freed.
+		/// Adds up over the life of the process.
+		qint64 savedBytes = 0;
+	};
+
+	/// returns the pooled copy of str, adding it to the pool if it isn't there yet
+	static QString intern(const QString &str);
+
+	/// drop strings that are only held by the pool. Returns how many were dropped.
+	static int prune();
+
+	static Stats stats();
+};
@@ -22,6 +22,8 @@
 #include <QtNetwork>
 #include <QtXml>
 #include <QRegExp>
+#include <QSaveFile>
+#include <QtConcurrentRun>
 
 #include "logger/QsLog.h"
 
@@ -152,9 +154,36 @@ void ForgeVersionList::sort()
 	// NO-OP for now
 }
 
+ForgeMinecraftVersionList::ForgeMinecraftVersionList(std::shared_ptr<ForgeVersionList> all,
+													 const QString &mcver, QObject *parent)
+	: ForgeVersionList(parent), m_all(all), m_mcver(mcver)
+{
+	connect(m_all.get(), SIGNAL(modelReset()), SLOT(refresh()));
+	refresh();
+}
+
+Task *ForgeMinecraftVersionList::getLoadTask()
+{
+	return m_all->getLoadTask();
+}
+
+bool ForgeMinecraftVersionList::isLoaded()
+{
+	return m_all->isLoaded();
+}
+
+void ForgeMinecraftVersionList::refresh()
+{
+	beginResetModel();
+	m_vlist = m_all->versionsFor(m_mcver);
+	m_loaded = m_all->isLoaded();
+	endResetModel();
+}
+
 ForgeListLoadTask::ForgeListLoadTask(ForgeVersionList *vlist) : Task()
 {
 	m_list = vlist;
+	connect(&m_parser, SIGNAL(finished()), SLOT(listParsed()));
 }
 
 void ForgeListLoadTask::executeTask()
@@ -162,17 +191,17 @@ void ForgeListLoadTask::executeTask()
 	setStatus(tr("Fetching Forge version lists..."));
 	auto job = new NetJob("Version index");
 	// we do not care if the version is stale or not.
-	auto forgeListEntry = MMC->metacache()->resolveEntry("minecraftforge", "list.json");
-	auto gradleForgeListEntry = MMC->metacache()->resolveEntry("minecraftforge", "json");
+	listEntry = MMC->metacache()->resolveEntry("minecraftforge", "list.json");
+	gradleListEntry = MMC->metacache()->resolveEntry("minecraftforge", "json");
 
 	// verify by poking the server.
-	forgeListEntry->stale = true;
-	gradleForgeListEntry->stale = true;
+	listEntry->stale = true;
+	gradleListEntry->stale = true;
 
 	job->addNetAction(listDownload = CacheDownload::make(QUrl(URLConstants::FORGE_LEGACY_URL),
-														 forgeListEntry));
+														 listEntry));
 	job->addNetAction(gradleListDownload = CacheDownload::make(
-						  QUrl(URLConstants::FORGE_GRADLE_URL), gradleForgeListEntry));
+						  QUrl(URLConstants::FORGE_GRADLE_URL), gradleListEntry));
 
 	connect(listDownload.get(), SIGNAL(failed(int)), SLOT(listFailed()));
 	connect(gradleListDownload.get(), SIGNAL(failed(int)), SLOT(gradleListFailed()));
@@ -183,19 +212,26 @@ void ForgeListLoadTask::executeTask()
 	listJob->start();
 }
 
-bool ForgeListLoadTask::parseForgeList(QList<BaseVersionPtr> &out)
+namespace
+{
+bool readListFile(const QString &filename, QByteArray &data, QString &error)
+{
+	QFile listFile(filename);
+	if (!listFile.open(QIODevice::ReadOnly))
+	{
+		error = QObject::tr("Can't open %1: %2").arg(filename, listFile.errorString());
+		return false;
+	}
+	data = listFile.readAll();
+	return true;
+}
+
+bool parseForgeList(const QString &filename, QList<BaseVersionPtr> &out, QString &error)
 {
 	QByteArray data;
+	if (!readListFile(filename, data, error))
 	{
-		auto dlJob = listDownload;
-		auto filename = std::dynamic_pointer_cast<CacheDownload>(dlJob)->getTargetFilepath();
-		QFile listFile(filename);
-		if (!listFile.open(QIODevice::ReadOnly))
-		{
-			return false;
-		}
-		data = listFile.readAll();
-		dlJob.reset();
+		return false;
 	}
 
 	QJsonParseError jsonError;
@@ -203,13 +239,13 @@ bool ForgeListLoadTask::parseForgeList(QList<BaseVersionPtr> &out)
 
 	if (jsonError.error != QJsonParseError::NoError)
 	{
-		emitFailed("Error parsing version list JSON:" + jsonError.errorString());
+		error = "Error parsing version list JSON:" + jsonError.errorString();
 		return false;
 	}
 
 	if (!jsonDoc.isObject())
 	{
-		emitFailed("Error parsing version list JSON: JSON root is not an object");
+		error = "Error parsing version list JSON: JSON root is not an object";
 		return false;
 	}
 
@@ -218,8 +254,7 @@ bool ForgeListLoadTask::parseForgeList(QList<BaseVersionPtr> &out)
 	// Now, get the array of versions.
 	if (!root.value("builds").isArray())
 	{
-		emitFailed(
-			"Error parsing version list JSON: version list object is missing 'builds' array");
+		error = "Error parsing version list JSON: version list object is missing 'builds' array";
 		return false;
 	}
 	QJsonArray builds = root.value("builds").toArray();
@@ -294,19 +329,12 @@ bool ForgeListLoadTask::parseForgeList(QList<BaseVersionPtr> &out)
 	return true;
 }
 
-bool ForgeListLoadTask::parseForgeGradleList(QList<BaseVersionPtr> &out)
+bool parseForgeGradleList(const QString &filename, QList<BaseVersionPtr> &out, QString &error)
 {
 	QByteArray data;
+	if (!readListFile(filename, data, error))
 	{
-		auto dlJob = gradleListDownload;
-		auto filename = std::dynamic_pointer_cast<CacheDownload>(dlJob)->getTargetFilepath();
-		QFile listFile(filename);
-		if (!listFile.open(QIODevice::ReadOnly))
-		{
-			return false;
-		}
-		data = listFile.readAll();
-		dlJob.reset();
+		return false;
 	}
 
 	QJsonParseError jsonError;
@@ -314,13 +342,13 @@ bool ForgeListLoadTask::parseForgeGradleList(QList<BaseVersionPtr> &out)
 
 	if (jsonError.error != QJsonParseError::NoError)
 	{
-		emitFailed("Error parsing gradle version list JSON:" + jsonError.errorString());
+		error = "Error parsing gradle version list JSON:" + jsonError.errorString();
 		return false;
 	}
 
 	if (!jsonDoc.isObject())
 	{
-		emitFailed("Error parsing gradle version list JSON: JSON root is not an object");
+		error = "Error parsing gradle version list JSON: JSON root is not an object";
 		return false;
 	}
 
@@ -336,10 +364,6 @@ bool ForgeListLoadTask::parseForgeGradleList(QList<BaseVersionPtr> &out)
 		QJsonObject number = it.value().toObject();
 		std::shared_ptr<ForgeVersion> fVersion(new ForgeVersion());
 		fVersion->m_buildnr = number.value("build").toDouble();
-		if(fVersion->m_buildnr >= 953 && fVersion->m_buildnr <= 965)
-		{
-			QLOG_DEBUG() << fVersion->m_buildnr;
-		}
 		fVersion->jobbuildver = number.value("version").toString();
 		fVersion->branch = number.value("branch").toString("");
 		fVersion->mcver = number.value("mcversion").toString();
@@ -406,32 +430,168 @@ bool ForgeListLoadTask::parseForgeGradleList(QList<BaseVersionPtr> &out)
 	return true;
 }
 
-void ForgeListLoadTask::listDownloaded()
+/*
+ * The index is the parsed content of both lists, grouped by Minecraft version and stored as
+ * binary JSON. It is tagged with the etags of the downloads it came from, so it stays valid
+ * for as long as the server keeps answering with a 304.
+ */
+QJsonObject versionToJson(const ForgeVersion &version)
+{
+	QJsonObject obj;
+	obj.insert("type", version.type == ForgeVersion::Gradle ? "gradle" : "legacy");
+	obj.insert("build", version.m_buildnr);
+	obj.insert("branch", version.branch);
+	obj.insert("universal_url", version.universal_url);
+	obj.insert("changelog_url", version.changelog_url);
+	obj.insert("installer_url", version.installer_url);
+	obj.insert("jobbuildver", version.jobbuildver);
+	obj.insert("mcver", version.mcver);
+	obj.insert("universal_filename", version.universal_filename);
+	obj.insert("installer_filename", version.installer_filename);
+	return obj;
+}
+
+ForgeVersionPtr versionFromJson(const QJsonObject &obj, const QString &mcver_sane)
 {
-	QList<BaseVersionPtr> list;
-	bool ret = true;
-	if (!parseForgeList(list))
+	ForgeVersionPtr version(new ForgeVersion());
+	version->type = obj.value("type").toString() == "gradle" ? ForgeVersion::Gradle
+															 : ForgeVersion::Legacy;
+	version->m_buildnr = obj.value("build").toDouble();
+	version->branch = obj.value("branch").toString();
+	version->universal_url = obj.value("universal_url").toString();
+	version->changelog_url = obj.value("changelog_url").toString();
+	version->installer_url = obj.value("installer_url").toString();
+	version->jobbuildver = obj.value("jobbuildver").toString();
+	version->mcver = obj.value("mcver").toString();
+	version->mcver_sane = mcver_sane;
+	version->universal_filename = obj.value("universal_filename").toString();
+	version->installer_filename = obj.value("installer_filename").toString();
+	return version;
+}
+
+bool readIndex(const QString &path, const QString &key,
+			   QMap<QString, QList<BaseVersionPtr>> &out)
+{
+	if (key.isEmpty())
+		return false;
+	QFile indexFile(path);
+	if (!indexFile.open(QIODevice::ReadOnly))
+		return false;
+	QJsonObject root = QJsonDocument::fromBinaryData(indexFile.readAll()).object();
+	if (root.value("key").toString() != key)
+		return false;
+
+	QJsonObject minecraft = root.value("minecraft").toObject();
+	for (auto it = minecraft.begin(); it != minecraft.end(); ++it)
+	{
+		auto &group = out[it.key()];
+		for (auto version : it.value().toArray())
+		{
+			group.append(versionFromJson(version.toObject(), it.key()));
+		}
+	}
+	return true;
+}
+
+void writeIndex(const QString &path, const QString &key, const QList<BaseVersionPtr> &versions)
+{
+	if (key.isEmpty())
+		return;
+	QMap<QString, QJsonArray> grouped;
+	for (auto base : versions)
+	{
+		auto version = std::dynamic_pointer_cast<ForgeVersion>(base);
+		grouped[version->mcver_sane].append(versionToJson(*version));
+	}
+	QJsonObject minecraft;
+	for (auto it = grouped.begin(); it != grouped.end(); ++it)
+	{
+		minecraft.insert(it.key(), it.value());
+	}
+	QJsonObject root;
+	root.insert("key", key);
+	root.insert("minecraft", minecraft);
+
+	QByteArray data = QJsonDocument(root).toBinaryData();
+	QSaveFile indexFile(path);
+	if (!indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+		indexFile.write(data) != data.size() || !indexFile.commit())
+	{
+		QLOG_WARN() << "Couldn't write the forge version index" << path;
+	}
+}
+
+ForgeListParseResult loadForgeLists(QString listPath, QString gradleListPath, QString indexPath,
+									QString key)
+{
+	ForgeListParseResult result;
+	auto newestFirst = [](const BaseVersionPtr & l, const BaseVersionPtr & r)
+	{ return (*l > *r); };
+	if (!readIndex(indexPath, key, result.byMinecraft))
 	{
-		ret = false;
+		result.byMinecraft.clear();
+		QList<BaseVersionPtr> versions;
+		if (!parseForgeList(listPath, versions, result.error) ||
+			!parseForgeGradleList(gradleListPath, versions, result.error))
+		{
+			return result;
+		}
+		writeIndex(indexPath, key, versions);
+		for (auto base : versions)
+		{
+			auto version = std::dynamic_pointer_cast<ForgeVersion>(base);
+			result.byMinecraft[version->mcver_sane].append(base);
+		}
 	}
-	if (!parseForgeGradleList(list))
+	for (auto &group : result.byMinecraft)
 	{
-		ret = false;
+		std::sort(group.begin(), group.end(), newestFirst);
+		result.versions.append(group);
 	}
+	std::sort(result.versions.begin(), result.versions.end(), newestFirst);
+	return result;
+}
 
-	if (!ret)
+/// what identifies the current content of a download
+QString entryKey(const MetaEntryPtr &entry)
+{
+	// not every server sends etags
+	return entry->etag.isEmpty() ? entry->md5sum : entry->etag;
+}
+}
+
+void ForgeListLoadTask::listDownloaded()
+{
+	setStatus(tr("Processing Forge version lists..."));
+	QString key;
+	const QString listKey = entryKey(listEntry);
+	const QString gradleListKey = entryKey(gradleListEntry);
+	if (!listKey.isEmpty() && !gradleListKey.isEmpty())
 	{
+		key = listKey + "|" + gradleListKey;
+	}
+	const QString gradleListPath = gradleListDownload->getTargetFilepath();
+	const QString indexPath = QFileInfo(gradleListPath).dir().absoluteFilePath("index.dat");
+	m_parser.setFuture(QtConcurrent::run(&loadForgeLists, listDownload->getTargetFilepath(),
+										 gradleListPath, indexPath, key));
+}
+
+void ForgeListLoadTask::listParsed()
+{
+	ForgeListParseResult result = m_parser.result();
+	if (!result.error.isEmpty())
+	{
+		emitFailed(result.error);
 		return;
 	}
-	std::sort(list.begin(), list.end(), [](const BaseVersionPtr & l, const BaseVersionPtr & r)
-	{ return (*l > *r); });
 
-	m_list->updateListData(list);
+	// the groups have to be there when the list tells everyone it changed
+	m_list->m_byMinecraft = result.byMinecraft;
+	m_list->updateListData(result.versions);
 
 	emitSucceeded();
 	return;
 }
-
 void ForgeListLoadTask::listFailed()
 {
 	auto reply = listDownload->m_reply;
@@ -19,6 +19,8 @@
 #include <QAbstractListModel>
 #include <QUrl>
 #include <QNetworkReply>
+#include <QFutureWatcher>
+#include <QMap>
 
 #include "logic/BaseVersionList.h"
 #include "logic/tasks/Task.h"
@@ -43,12 +45,20 @@ public:
 
 	ForgeVersionPtr findVersionByVersionNr(QString version);
 
+	/// the versions for one Minecraft version, newest first
+	QList<BaseVersionPtr> versionsFor(const QString &mcver) const
+	{
+		return m_byMinecraft.value(mcver);
+	}
+
 	virtual QVariant data(const QModelIndex &index, int role) const;
 	virtual QVariant headerData(int section, Qt::Orientation orientation, int role) const;
 	virtual int columnCount(const QModelIndex &parent) const;
 
 protected:
 	QList<BaseVersionPtr> m_vlist;
+	/// the same versions, by Minecraft version
+	QMap<QString, QList<BaseVersionPtr>> m_byMinecraft;
 
 	bool m_loaded = false;
 
@@ -57,6 +67,41 @@ slots:
 	virtual void updateListData(QList<BaseVersionPtr> versions);
 };
 
+/**
+ * The Forge versions for one Minecraft version, for the version pickers.
+ *
+ * Shows one group of the full list as it is, so the picker doesn't have to filter through
+ * thousands of versions. Loading it loads the full list, and it follows any changes to it.
+ */
+class ForgeMinecraftVersionList : public ForgeVersionList
+{
+	Q_OBJECT
+public:
+	ForgeMinecraftVersionList(std::shared_ptr<ForgeVersionList> all, const QString &mcver,
+							  QObject *parent = 0);
+
+	virtual Task *getLoadTask();
+	virtual bool isLoaded();
+
+private
+slots:
+	void refresh();
+
+private:
+	std::shared_ptr<ForgeVersionList> m_all;
+	QString m_mcver;
+};
+
+/// what the worker thread of ForgeListLoadTask hands back
+struct ForgeListParseResult
+{
+	/// newest first
+	QList<BaseVersionPtr> versions;
+	/// the same versions, by Minecraft version
+	QMap<QString, QList<BaseVersionPtr>> byMinecraft;
+	QString error;
+};
+
 class ForgeListLoadTask : public Task
 {
 	Q_OBJECT
@@ -71,15 +116,17 @@ slots:
 	void listDownloaded();
 	void listFailed();
 	void gradleListFailed();
+	void listParsed();
 
 protected:
 	NetJobPtr listJob;
 	ForgeVersionList *m_list;
 
+	MetaEntryPtr listEntry;
+	MetaEntryPtr gradleListEntry;
 	CacheDownloadPtr listDownload;
 	CacheDownloadPtr gradleListDownload;
 
-private:
-	bool parseForgeList(QList<BaseVersionPtr> &out);
-	bool parseForgeGradleList(QList<BaseVersionPtr> &out);
+	/// parsing the lists (several MB of JSON) happens in a worker thread
+	QFutureWatcher<ForgeListParseResult> m_parser;
 };
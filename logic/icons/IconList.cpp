@@ -21,13 +21,157 @@
 #include <QMimeData>
 #include <QUrl>
 #include <QFileSystemWatcher>
+#include <QIconEngine>
+#include <QImageReader>
+#include <QPainter>
+#include <QPointer>
+#include <QRunnable>
+#include <QApplication>
+#include <QStyle>
+#include <QStyleOption>
 #include <MultiMC.h>
 #include <logic/settings/Setting.h>
 
 #define MAX_SIZE 1024
+// decoded images are kept up to this many KiB
+#define PIXMAP_CACHE_SIZE (16 * 1024)
+
+// images are decoded to fit one of these sizes, whichever is the first big enough one
+static const int sizeBuckets[] = {16, 24, 32, 48, 64, 128, 256, 512, MAX_SIZE};
+
+static int sizeBucket(const QSize &size)
+{
+	const int side = qMax(size.width(), size.height());
+	for (int bucket : sizeBuckets)
+	{
+		if (bucket >= side)
+			return bucket;
+	}
+	return MAX_SIZE;
+}
+
+static QImage decodeImage(const QString &path, int bucket)
+{
+	QImageReader reader(path);
+	const QSize size = reader.size();
+	// never scale up, that's left to whoever draws the image
+	if (size.isValid() && (size.width() > bucket || size.height() > bucket))
+	{
+		reader.setScaledSize(size.scaled(bucket, bucket, Qt::KeepAspectRatio));
+	}
+	return reader.read();
+}
+
+class IconDecodeRunnable : public QRunnable
+{
+public:
+	IconDecodeRunnable(IconList *list, QString cacheKey, QString path, int bucket)
+		: m_list(list), m_cacheKey(cacheKey), m_path(path), m_bucket(bucket)
+	{
+	}
+	void run()
+	{
+		QImage image = decodeImage(m_path, m_bucket);
+		QMetaObject::invokeMethod(m_list, "iconDecoded", Qt::QueuedConnection,
+								  Q_ARG(QString, m_cacheKey), Q_ARG(QString, m_path),
+								  Q_ARG(QImage, image));
+	}
+
+private:
+	// the list waits for all the decoding to finish before it goes away
+	IconList *m_list;
+	QString m_cacheKey;
+	QString m_path;
+	int m_bucket;
+};
+
+/**
+ * Draws an icon file through the IconList pixmap cache.
+ *
+ * Nothing is decoded until the icon is drawn. Asynchronous engines hand out a transparent
+ * placeholder until the image is ready.
+ */
+class LazyIconEngine : public QIconEngine
+{
+public:
+	LazyIconEngine(IconList *list, const MMCImage &image, bool async)
+		: m_list(list), m_path(image.filename), m_size(image.size),
+		  m_stamp(image.changed.toMSecsSinceEpoch()), m_async(async)
+	{
+	}
+	void paint(QPainter *painter, const QRect &rect, QIcon::Mode mode, QIcon::State state)
+	{
+		const QPixmap pm = pixmap(rect.size(), mode, state);
+		const QRect target = QStyle::alignedRect(Qt::LeftToRight, Qt::AlignCenter,
+												 pm.size() / pm.devicePixelRatio(), rect);
+		painter->drawPixmap(target, pm);
+	}
+	QSize actualSize(const QSize &size, QIcon::Mode mode, QIcon::State state)
+	{
+		Q_UNUSED(mode);
+		Q_UNUSED(state);
+		if (!m_size.isValid())
+			return size;
+		if (m_size.width() <= size.width() && m_size.height() <= size.height())
+			return m_size;
+		return m_size.scaled(size, Qt::KeepAspectRatio);
+	}
+	QPixmap pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state)
+	{
+		const QSize actual = actualSize(size, mode, state);
+		QPixmap pm;
+		if (m_list)
+		{
+			pm = m_list->decodedPixmap(m_path, m_stamp, actual, m_async);
+		}
+		else
+		{
+			pm = QPixmap::fromImage(decodeImage(m_path, sizeBucket(actual)));
+		}
+		if (pm.isNull())
+		{
+			pm = QPixmap(actual);
+			pm.fill(Qt::transparent);
+			return pm;
+		}
+		// the decoded image only fits the size bucket
+		if (pm.width() > actual.width() || pm.height() > actual.height())
+		{
+			pm = pm.scaled(actual, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+		}
+		if (mode != QIcon::Normal && qobject_cast<QApplication *>(qApp))
+		{
+			QStyleOption opt(0);
+			opt.palette = QApplication::palette();
+			pm = QApplication::style()->generatedIconPixmap(mode, pm, &opt);
+		}
+		return pm;
+	}
+	QList<QSize> availableSizes(QIcon::Mode mode, QIcon::State state) const
+	{
+		Q_UNUSED(mode);
+		Q_UNUSED(state);
+		if (!m_size.isValid())
+			return QList<QSize>();
+		return QList<QSize>() << m_size;
+	}
+	QIconEngine *clone() const
+	{
+		return new LazyIconEngine(*this);
+	}
+
+private:
+	QPointer<IconList> m_list;
+	QString m_path;
+	QSize m_size;
+	qint64 m_stamp;
+	bool m_async;
+};
 
 IconList::IconList(QObject *parent) : QAbstractListModel(parent)
 {
+	m_pixmaps.setMaxCost(PIXMAP_CACHE_SIZE);
+
 	// add builtin icons
 	QDir instance_icons(":/icons/instances/");
 	auto file_info_list = instance_icons.entryInfoList(QDir::Files, QDir::Name);
@@ -50,6 +194,85 @@ IconList::IconList(QObject *parent) : QAbstractListModel(parent)
 	directoryChanged(path);
 }
 
+IconList::~IconList()
+{
+	// the decoders report back to this object
+	m_decodePool.clear();
+	m_decodePool.waitForDone();
+}
+
+bool IconList::readImage(const QString &path, QSize &size)
+{
+	// only looks at the header, the image itself is decoded when it's needed
+	QImageReader reader(path);
+	if (!reader.canRead())
+		return false;
+	size = reader.size();
+	return true;
+}
+
+void IconList::setupIcons(MMCImage &image)
+{
+	image.icon = QIcon(new LazyIconEngine(this, image, false));
+	image.viewIcon = QIcon(new LazyIconEngine(this, image, true));
+}
+
+QPixmap IconList::decodedPixmap(const QString &path, qint64 stamp, const QSize &size, bool async)
+{
+	const int bucket = sizeBucket(size);
+	const QString cacheKey = QString("%1|%2|%3").arg(bucket).arg(stamp).arg(path);
+	if (auto cached = m_pixmaps.object(cacheKey))
+	{
+		return *cached;
+	}
+	if (async)
+	{
+		if (!m_pendingDecodes.contains(cacheKey))
+		{
+			m_pendingDecodes.insert(cacheKey);
+			m_decodePool.start(new IconDecodeRunnable(this, cacheKey, path, bucket));
+		}
+		return QPixmap();
+	}
+	QPixmap pixmap = QPixmap::fromImage(decodeImage(path, bucket));
+	m_pixmaps.insert(cacheKey, new QPixmap(pixmap),
+					 qMax(1, pixmap.width() * pixmap.height() * pixmap.depth() / (8 * 1024)));
+	return pixmap;
+}
+
+void IconList::iconDecoded(QString cacheKey, QString path, QImage image)
+{
+	m_pendingDecodes.remove(cacheKey);
+	if (image.isNull())
+	{
+		QLOG_WARN() << "Couldn't decode icon" << path;
+	}
+	// failures are cached too, so they aren't retried on every paint
+	QPixmap *pixmap = new QPixmap(QPixmap::fromImage(image));
+	m_pixmaps.insert(cacheKey, pixmap,
+					 qMax(1, pixmap->width() * pixmap->height() * pixmap->depth() / (8 * 1024)));
+
+	// new view icons, so anything that cached the placeholder by icon notices the change
+	for (int i = 0; i < icons.size(); i++)
+	{
+		auto &icon = icons[i];
+		bool changed = false;
+		for (auto &entry : icon.m_images)
+		{
+			if (entry.filename == path && !entry.viewIcon.isNull())
+			{
+				entry.viewIcon = QIcon(new LazyIconEngine(this, entry, true));
+				changed = true;
+			}
+		}
+		if (changed)
+		{
+			dataChanged(index(i), index(i));
+			emit iconUpdated(icon.m_key);
+		}
+	}
+}
+
 void IconList::directoryChanged(const QString &path)
 {
 	QDir new_dir (path);
@@ -134,11 +357,13 @@ void IconList::fileChanged(const QString &path)
 	int idx = getIconIndex(key);
 	if (idx == -1)
 		return;
-	QIcon icon(path);
-	if (!icon.availableSizes().size())
+	QSize size;
+	if (!readImage(path, size))
 		return;
 
-	icons[idx].m_images[MMCIcon::FileBased].icon = icon;
+	auto &icon = icons[idx];
+	icon.replace(MMCIcon::FileBased, path, size);
+	setupIcons(icon.m_images[MMCIcon::FileBased]);
 	dataChanged(index(idx), index(idx));
 	emit iconUpdated(key);
 }
@@ -233,7 +458,7 @@ QVariant IconList::data(const QModelIndex &index, int role) const
 	switch (role)
 	{
 	case Qt::DecorationRole:
-		return icons[row].icon();
+		return icons[row].viewIcon();
 	case Qt::DisplayRole:
 		return icons[row].name();
 	case Qt::UserRole:
@@ -282,14 +507,15 @@ bool IconList::deleteIcon(QString key)
 bool IconList::addIcon(QString key, QString name, QString path, MMCIcon::Type type)
 {
 	// replace the icon even? is the input valid?
-	QIcon icon(path);
-	if (!icon.availableSizes().size())
+	QSize size;
+	if (!readImage(path, size))
 		return false;
 	auto iter = name_index.find(key);
 	if (iter != name_index.end())
 	{
 		auto &oldOne = icons[*iter];
-		oldOne.replace(type, icon, path);
+		oldOne.replace(type, path, size);
+		setupIcons(oldOne.m_images[type]);
 		dataChanged(index(*iter), index(*iter));
 		return true;
 	}
@@ -301,7 +527,8 @@ bool IconList::addIcon(QString key, QString name, QString path, MMCIcon::Type ty
 			MMCIcon mmc_icon;
 			mmc_icon.m_name = name;
 			mmc_icon.m_key = key;
-			mmc_icon.replace(type, icon, path);
+			mmc_icon.replace(type, path, size);
+			setupIcons(mmc_icon.m_images[type]);
 			icons.push_back(mmc_icon);
 			name_index[key] = icons.size() - 1;
 		}
@@ -336,6 +563,21 @@ QIcon IconList::getIcon(QString key)
 	return QIcon();
 }
 
+QIcon IconList::getViewIcon(QString key)
+{
+	int icon_index = getIconIndex(key);
+
+	if (icon_index != -1)
+		return icons[icon_index].viewIcon();
+
+	// Fallback for icons that don't exist.
+	icon_index = getIconIndex("infinity");
+
+	if (icon_index != -1)
+		return icons[icon_index].viewIcon();
+	return QIcon();
+}
+
 QIcon IconList::getBigIcon(QString key)
 {
 	int icon_index = getIconIndex(key);
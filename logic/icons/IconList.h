@@ -19,21 +19,37 @@
 #include <QAbstractListModel>
 #include <QFile>
 #include <QDir>
+#include <QCache>
+#include <QSet>
+#include <QThreadPool>
 #include <QtGui/QIcon>
+#include <QtGui/QImage>
+#include <QtGui/QPixmap>
 #include <memory>
 #include "MMCIcon.h"
 #include "logic/settings/Setting.h"
 
 class QFileSystemWatcher;
 
+/**
+ * The instance icons.
+ *
+ * Icons are only registered by path. The images are decoded the first time they are drawn,
+ * at the size they are drawn at (rounded up to a few fixed sizes), and the results are kept
+ * in a bounded LRU cache. Icons for item views are decoded in the background and show a
+ * placeholder until they are ready.
+ */
 class IconList : public QAbstractListModel
 {
 	Q_OBJECT
 public:
 	explicit IconList(QObject *parent = 0);
-	virtual ~IconList() {};
+	virtual ~IconList();
 
+	/// icon that is decoded right away when it's drawn
 	QIcon getIcon(QString key);
+	/// icon for item views, decoded in the background. iconUpdated() is emitted when it's ready.
+	QIcon getViewIcon(QString key);
 	QIcon getBigIcon(QString key);
 	int getIconIndex(QString key);
 
@@ -54,6 +70,14 @@ public:
 	void startWatching();
 	void stopWatching();
 
+	/**
+	 * @brief get an icon image decoded to fit a size, from the cache if possible
+	 * @param stamp modification time of the file, so changed files are decoded again
+	 * @param async when the image isn't in the cache, decode it in the background and return
+	 *        a null pixmap for now
+	 */
+	QPixmap decodedPixmap(const QString &path, qint64 stamp, const QSize &size, bool async);
+
 signals:
 	void iconUpdated(QString key);
 
@@ -63,16 +87,25 @@ private:
 	// hide assign op
 	IconList &operator=(const IconList &) = delete;
 	void reindex();
+	bool readImage(const QString &path, QSize &size);
+	void setupIcons(MMCImage &image);
 
 protected
 slots:
 	void directoryChanged(const QString &path);
 	void fileChanged(const QString &path);
 	void SettingChanged(const Setting & setting, QVariant value);
+	void iconDecoded(QString cacheKey, QString path, QImage image);
 private:
 	std::shared_ptr<QFileSystemWatcher> m_watcher;
 	bool is_watching;
 	QMap<QString, int> name_index;
 	QVector<MMCIcon> icons;
 	QDir m_dir;
+
+	/// decoded images, cost in KiB
+	QCache<QString, QPixmap> m_pixmaps;
+	/// cache keys of the images being decoded in the background
+	QSet<QString> m_pendingDecodes;
+	QThreadPool m_decodePool;
 };
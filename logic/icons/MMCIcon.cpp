@@ -61,10 +61,18 @@ QIcon MMCIcon::icon() const
 	return m_images[m_current_type].icon;
 }
 
+QIcon MMCIcon::viewIcon() const
+{
+	if (m_current_type == Type::ToBeDeleted)
+		return QIcon();
+	return m_images[m_current_type].viewIcon;
+}
+
 void MMCIcon::remove(Type rm_type)
 {
 	m_images[rm_type].filename = QString();
 	m_images[rm_type].icon = QIcon();
+	m_images[rm_type].viewIcon = QIcon();
 	for (auto iter = rm_type; iter != Type::ToBeDeleted; iter--)
 	{
 		if (m_images[iter].present())
@@ -76,14 +84,14 @@ void MMCIcon::remove(Type rm_type)
 	m_current_type = Type::ToBeDeleted;
 }
 
-void MMCIcon::replace(MMCIcon::Type new_type, QIcon icon, QString path)
+void MMCIcon::replace(MMCIcon::Type new_type, QString path, QSize size)
 {
 	QFileInfo foo(path);
 	if (new_type > m_current_type || m_current_type == MMCIcon::ToBeDeleted)
 	{
 		m_current_type = new_type;
 	}
-	m_images[new_type].icon = icon;
 	m_images[new_type].changed = foo.lastModified();
 	m_images[new_type].filename = path;
+	m_images[new_type].size = size;
 }
@@ -17,11 +17,17 @@
 #include <QString>
 #include <QDateTime>
 #include <QIcon>
+#include <QSize>
 struct MMCImage
 {
+	/// decoded on the calling thread the first time it's drawn, see IconList
 	QIcon icon;
+	/// decoded in the background, for item views
+	QIcon viewIcon;
 	QString filename;
 	QDateTime changed;
+	/// size of the image file, invalid if it couldn't be read without decoding the file
+	QSize size;
 	bool present() const
 	{
 		return !icon.isNull();
@@ -47,6 +53,8 @@ struct MMCIcon
 	QString name() const;
 	bool has(Type _type) const;
 	QIcon icon() const;
+	QIcon viewIcon() const;
 	void remove(Type rm_type);
-	void replace(Type new_type, QIcon icon, QString path = QString());
+	/// point the image of a type at a file. The icons have to be set up by the caller.
+	void replace(Type new_type, QString path, QSize size);
 };
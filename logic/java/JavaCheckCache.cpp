@@ -0,0 +1,159 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JavaCheckCache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+JavaCheckCache::JavaCheckCache(const QString &indexFile) : m_indexFile(indexFile)
+{
+}
+
+JavaCheckCache::Key JavaCheckCache::keyFor(const QString &path)
+{
+	QString binary = path;
+	if (!binary.contains('/') && !binary.contains('\\'))
+	{
+		binary = QStandardPaths::findExecutable(binary);
+		if (binary.isEmpty())
+			return Key();
+	}
+	// follows symlinks, like /usr/bin/java -> /etc/alternatives/java -> the real thing
+	const QString realPath = QFileInfo(binary).canonicalFilePath();
+	if (realPath.isEmpty())
+		return Key();
+	QFileInfo info(realPath);
+	if (!info.isFile())
+		return Key();
+
+	Key key;
+	key.realPath = realPath;
+	key.size = info.size();
+	key.mtime = info.lastModified().toMSecsSinceEpoch();
+	return key;
+}
+
+bool JavaCheckCache::get(const Key &key, JavaCheckResult &result)
+{
+	load();
+	auto iter = m_entries.constFind(key.realPath);
+	if (iter == m_entries.constEnd())
+		return false;
+	if (iter->size != key.size || iter->mtime != key.mtime)
+		return false;
+	result = iter->result;
+	return true;
+}
+
+void JavaCheckCache::put(const Key &key, const JavaCheckResult &result)
+{
+	load();
+	if (!key.isValid())
+		return;
+	if (!result.valid)
+	{
+		// whatever was there before is outdated now
+		if (m_entries.remove(key.realPath))
+			m_dirty = true;
+		return;
+	}
+	Entry entry;
+	entry.size = key.size;
+	entry.mtime = key.mtime;
+	entry.result = result;
+	m_entries.insert(key.realPath, entry);
+	m_dirty = true;
+}
+
+void JavaCheckCache::load()
+{
+	if (m_loaded)
+		return;
+	m_loaded = true;
+
+	QFile index(m_indexFile);
+	if (!index.open(QIODevice::ReadOnly))
+		return;
+
+	QJsonDocument json = QJsonDocument::fromJson(index.readAll());
+	if (!json.isObject())
+		return;
+	auto root = json.object();
+	// check file version first
+	if (root.value("version").toString() != "1")
+		return;
+
+	for (auto element : root.value("entries").toArray())
+	{
+		auto obj = element.toObject();
+		const QString realPath = obj.value("path").toString();
+		if (realPath.isEmpty())
+			continue;
+		Entry entry;
+		entry.size = obj.value("size").toDouble();
+		entry.mtime = obj.value("mtime").toDouble();
+		entry.result.path = realPath;
+		entry.result.javaVersion = obj.value("version").toString();
+		entry.result.realPlatform = obj.value("arch").toString();
+		entry.result.is_64bit = obj.value("64bit").toBool();
+		entry.result.mojangPlatform = entry.result.is_64bit ? "64" : "32";
+		entry.result.valid = true;
+		m_entries.insert(realPath, entry);
+	}
+}
+
+bool JavaCheckCache::save()
+{
+	if (!m_dirty)
+		return true;
+
+	QJsonArray entries;
+	for (auto iter = m_entries.constBegin(); iter != m_entries.constEnd(); iter++)
+	{
+		QJsonObject obj;
+		obj.insert("path", iter.key());
+		obj.insert("size", double(iter->size));
+		obj.insert("mtime", double(iter->mtime));
+		obj.insert("version", iter->result.javaVersion);
+		obj.insert("arch", iter->result.realPlatform);
+		obj.insert("64bit", iter->result.is_64bit);
+		entries.append(obj);
+	}
+	QJsonObject root;
+	root.insert("version", QString("1"));
+	root.insert("entries", entries);
+
+	QDir().mkpath(QFileInfo(m_indexFile).absolutePath());
+	QSaveFile file(m_indexFile);
+	if (!file.open(QIODevice::WriteOnly))
+		return false;
+	const QByteArray data = QJsonDocument(root).toJson();
+	if (file.write(data) != data.size())
+	{
+		file.cancelWriting();
+		return false;
+	}
+	if (!file.commit())
+		return false;
+	m_dirty = false;
+	return true;
+}
@@ -0,0 +1,77 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+
+#include "JavaChecker.h"
+
+/**
+ * Results of the Java checker, kept on disk so Java binaries don't have to be run every time
+ * the list of Java installations is loaded.
+ *
+ * Entries are keyed on the real path of the binary. They are only used while its size and
+ * modification time stay the same, so an updated or replaced Java is checked again.
+ * Only successful checks are stored, a failed one may have been a fluke (a timeout, for example).
+ */
+class JavaCheckCache
+{
+public:
+	/// identifies a Java binary on disk
+	struct Key
+	{
+		QString realPath;
+		qint64 size = -1;
+		qint64 mtime = 0;
+		bool isValid() const
+		{
+			return !realPath.isEmpty();
+		}
+	};
+
+	explicit JavaCheckCache(const QString &indexFile);
+
+	/**
+	 * Resolve a Java path (or a plain name looked up in PATH, like "java") and look at the
+	 * binary. The key is invalid if there is no such file.
+	 * Doesn't touch any cache state, so it can be used from any thread.
+	 */
+	static Key keyFor(const QString &path);
+
+	/// the stored result for a binary, if there is an up to date one
+	bool get(const Key &key, JavaCheckResult &result);
+	/// store the result of checking a binary. Results of failed checks are ignored.
+	void put(const Key &key, const JavaCheckResult &result);
+
+	/// write the index file, if anything changed
+	bool save();
+
+private:
+	void load();
+
+private:
+	struct Entry
+	{
+		qint64 size;
+		qint64 mtime;
+		JavaCheckResult result;
+	};
+	QString m_indexFile;
+	QHash<QString, Entry> m_entries;
+	bool m_loaded = false;
+	bool m_dirty = false;
+};
@@ -31,6 +31,19 @@ void JavaCheckerJob::partFinished(JavaCheckResult result)
 	if (num_finished == javacheckers.size())
 	{
 		emit finished(javaresults);
+		return;
+	}
+	startNext();
+}
+
+void JavaCheckerJob::startNext()
+{
+	// every check is a JVM starting up, don't run too many of them at once
+	while (num_started < javacheckers.size() && num_started - num_finished < m_maxParallel)
+	{
+		auto checker = javacheckers[num_started++];
+		connect(checker.get(), SIGNAL(checkFinished(JavaCheckResult)), SLOT(partFinished(JavaCheckResult)));
+		checker->performCheck();
 	}
 }
 
@@ -38,10 +51,9 @@ void JavaCheckerJob::start()
 {
 	QLOG_INFO() << m_job_name.toLocal8Bit() << " started.";
 	m_running = true;
-	for (auto iter : javacheckers)
+	for (int i = 0; i < javacheckers.size(); i++)
 	{
 		javaresults.append(JavaCheckResult());
-		connect(iter.get(), SIGNAL(checkFinished(JavaCheckResult)), SLOT(partFinished(JavaCheckResult)));
-		iter->performCheck();
 	}
+	startNext();
 }
@@ -33,17 +33,22 @@ public:
 	{
 		javacheckers.append(base);
 		total_progress++;
-		// if this is already running, the action needs to be started right away!
+		// if this is already running, the action needs to be started as soon as there's room
 		if (isRunning())
 		{
+			javaresults.append(JavaCheckResult());
 			emit progress(current_progress, total_progress);
-			connect(base.get(), SIGNAL(checkFinished(JavaCheckResult)), SLOT(partFinished(JavaCheckResult)));
-
-			base->performCheck();
+			startNext();
 		}
 		return true;
 	}
 
+	/// how many Java processes can run at the same time
+	void setMaxParallel(int maxParallel)
+	{
+		m_maxParallel = qMax(1, maxParallel);
+	}
+
 	JavaCheckerPtr operator[](int index)
 	{
 		return javacheckers[index];
@@ -77,6 +82,9 @@ private
 slots:
 	void partFinished(JavaCheckResult result);
 
+private:
+	void startNext();
+
 private:
 	QString m_job_name;
 	QList<JavaCheckerPtr> javacheckers;
@@ -84,5 +92,8 @@ private:
 	qint64 current_progress = 0;
 	qint64 total_progress = 0;
 	int num_finished = 0;
+	/// index of the next checker to start
+	int num_started = 0;
+	int m_maxParallel = 4;
 	bool m_running = false;
 };
@@ -16,7 +16,7 @@
 #include <QStringList>
 #include <QString>
 #include <QDir>
-#include <QStringList>
+#include <QFileInfo>
 
 #include <logic/settings/Setting.h>
 #include <pathutils.h>
@@ -43,6 +43,37 @@ JavaVersionPtr JavaUtils::MakeJavaPtr(QString path, QString id, QString arch)
 	return javaVersion;
 }
 
+QList<QString> JavaUtils::FindJavasInDirs(const QStringList &dirs)
+{
+#if WINDOWS
+	const QString binaryName = "javaw.exe";
+#else
+	const QString binaryName = "java";
+#endif
+	QList<QString> javas;
+	for (auto &dirPath : dirs)
+	{
+		QDir dir(dirPath);
+		if (dirPath.isEmpty() || !dir.exists())
+			continue;
+		QStringList homes = {dir.absolutePath()};
+		for (auto &entry : dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name))
+		{
+			homes.append(dir.absoluteFilePath(entry));
+		}
+		for (auto &home : homes)
+		{
+			for (auto &candidate : {PathCombine(home, "bin", binaryName),
+									PathCombine(home, "jre/bin", binaryName)})
+			{
+				if (QFileInfo(candidate).isFile())
+					javas.append(candidate);
+			}
+		}
+	}
+	return javas;
+}
+
 JavaVersionPtr JavaUtils::GetDefaultJava()
 {
 	JavaVersionPtr javaVersion(new JavaVersion());
@@ -199,12 +230,19 @@ QList<QString> JavaUtils::FindJavaPaths()
 #elif LINUX
 QList<QString> JavaUtils::FindJavaPaths()
 {
-	QLOG_INFO() << "Linux Java detection incomplete - defaulting to \"java\"";
-
 	QList<QString> javas;
 	javas.append(this->GetDefaultJava()->path);
-    javas.append("/opt/java/bin/java");
-    javas.append("/usr/bin/java");
+	javas.append("/opt/java/bin/java");
+	javas.append("/usr/bin/java");
+
+	QString javaHome = QString::fromLocal8Bit(qgetenv("JAVA_HOME"));
+	if (!javaHome.isEmpty())
+	{
+		javas.append(PathCombine(javaHome, "bin", "java"));
+	}
+	// distribution packages, manual installs and SDKMAN
+	javas.append(FindJavasInDirs({"/usr/lib/jvm", "/usr/lib64/jvm", "/usr/lib32/jvm", "/usr/java",
+								  "/opt", QDir::home().absoluteFilePath(".sdkman/candidates/java")}));
 
 	return javas;
 }
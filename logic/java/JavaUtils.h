@@ -35,6 +35,8 @@ public:
 
 	JavaVersionPtr MakeJavaPtr(QString path, QString id = "unknown", QString arch = "unknown");
 	QList<QString> FindJavaPaths();
+	/// Java binaries in the given folders, and in their direct subfolders (one Java installation each)
+	QList<QString> FindJavasInDirs(const QStringList &dirs);
 	JavaVersionPtr GetDefaultJava();
 
 #if WINDOWS
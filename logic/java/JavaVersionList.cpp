@@ -16,6 +16,9 @@
 #include <QtNetwork>
 #include <QtXml>
 #include <QRegExp>
+#include <QSet>
+#include <QThread>
+#include <QtConcurrentRun>
 
 #include "MultiMC.h"
 #include "logger/QsLog.h"
@@ -24,7 +27,8 @@
 #include "logic/java/JavaCheckerJob.h"
 #include "logic/java/JavaUtils.h"
 
-JavaVersionList::JavaVersionList(QObject *parent) : BaseVersionList(parent)
+JavaVersionList::JavaVersionList(QObject *parent)
+	: BaseVersionList(parent), m_checkCache(QDir("cache/javacheck.json").absolutePath())
 {
 }
 
@@ -174,27 +178,78 @@ void JavaListLoadTask::executeTask()
 {
 	setStatus(tr("Detecting Java installations..."));
 
+	connect(&m_scanner, SIGNAL(finished()), SLOT(scanFinished()));
+	QStringList extraDirs =
+		MMC->settings()->get("JavaSearchDirs").toString().split(';', QString::SkipEmptyParts);
+	m_scanner.setFuture(QtConcurrent::run(&JavaListLoadTask::scan, extraDirs));
+}
+
+QList<JavaCandidate> JavaListLoadTask::scan(QStringList extraDirs)
+{
 	JavaUtils ju;
-	QList<QString> candidate_paths = ju.FindJavaPaths();
+	QList<QString> paths = ju.FindJavaPaths();
+	paths.append(ju.FindJavasInDirs(extraDirs));
+
+	QList<JavaCandidate> candidates;
+	QSet<QString> seen;
+	for (auto &path : paths)
+	{
+		if (seen.contains(path))
+			continue;
+		seen.insert(path);
+		JavaCandidate candidate;
+		candidate.path = path;
+		candidate.key = JavaCheckCache::keyFor(path);
+		// there's nothing to run
+		if (!candidate.key.isValid())
+			continue;
+		candidates.append(candidate);
+	}
+	return candidates;
+}
+
+void JavaListLoadTask::scanFinished()
+{
+	m_candidates = m_scanner.result();
+	auto &cache = m_list->checkCache();
 
 	m_job = std::shared_ptr<JavaCheckerJob>(new JavaCheckerJob("Java detection"));
 	connect(m_job.get(), SIGNAL(finished(QList<JavaCheckResult>)), this, SLOT(javaCheckerFinished(QList<JavaCheckResult>)));
 	connect(m_job.get(), SIGNAL(progress(int, int)), this, SLOT(checkerProgress(int, int)));
+	m_job->setMaxParallel(qBound(1, QThread::idealThreadCount() / 2, 4));
 
+	// symlinks often lead to the same binary, only check it once. Unchanged binaries aren't
+	// checked at all.
 	QLOG_DEBUG() << "Probing the following Java paths: ";
-	int id = 0;
-	for(QString candidate : candidate_paths)
+	QSet<QString> queued;
+	for (auto &candidate : m_candidates)
 	{
-		QLOG_DEBUG() << " " << candidate;
+		const QString &realPath = candidate.key.realPath;
+		if (queued.contains(realPath) || m_results.contains(realPath))
+			continue;
+
+		JavaCheckResult result;
+		if (cache.get(candidate.key, result))
+		{
+			QLOG_DEBUG() << " " << candidate.path << "(cached)";
+			m_results.insert(realPath, result);
+			continue;
+		}
+		QLOG_DEBUG() << " " << candidate.path;
+		queued.insert(realPath);
 
 		auto candidate_checker = new JavaChecker();
-		candidate_checker->path = candidate;
-		candidate_checker->id = id;
+		candidate_checker->path = candidate.path;
+		candidate_checker->id = m_checking.size();
+		m_checking.append(candidate.key);
 		m_job->addJavaCheckerAction(JavaCheckerPtr(candidate_checker));
-
-		id++;
 	}
 
+	if (m_job->size() == 0)
+	{
+		finish();
+		return;
+	}
 	m_job->start();
 }
 
@@ -205,14 +260,29 @@ void JavaListLoadTask::checkerProgress(int current, int total)
 }
 
 void JavaListLoadTask::javaCheckerFinished(QList<JavaCheckResult> results)
+{
+	auto &cache = m_list->checkCache();
+	for (auto &result : results)
+	{
+		const auto &key = m_checking[result.id];
+		cache.put(key, result);
+		m_results.insert(key.realPath, result);
+	}
+	cache.save();
+	finish();
+}
+
+void JavaListLoadTask::finish()
 {
 	QList<JavaVersionPtr> candidates;
 
 	QLOG_DEBUG() << "Found the following valid Java installations:";
-	for(JavaCheckResult result : results)
+	for (auto &candidate : m_candidates)
 	{
+		JavaCheckResult result = m_results.value(candidate.key.realPath);
 		if(result.valid)
 		{
+			result.path = candidate.path;
 			JavaVersionPtr javaVersion(new JavaVersion());
 
 			javaVersion->id = result.javaVersion;
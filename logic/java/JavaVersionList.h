@@ -17,10 +17,12 @@
 
 #include <QObject>
 #include <QAbstractListModel>
+#include <QFutureWatcher>
 
 #include "logic/BaseVersionList.h"
 #include "logic/tasks/Task.h"
 #include "logic/java/JavaCheckerJob.h"
+#include "logic/java/JavaCheckCache.h"
 
 class JavaListLoadTask;
 
@@ -62,6 +64,12 @@ public:
 
 	virtual BaseVersionPtr getTopRecommended() const;
 
+	/// results of checking Java binaries, shared by all the loads of the list
+	JavaCheckCache &checkCache()
+	{
+		return m_checkCache;
+	}
+
 	virtual QVariant data(const QModelIndex &index, int role) const;
 	virtual QVariant headerData(int section, Qt::Orientation orientation, int role) const;
 	virtual int columnCount(const QModelIndex &parent) const;
@@ -72,10 +80,18 @@ slots:
 
 protected:
 	QList<BaseVersionPtr> m_vlist;
+	JavaCheckCache m_checkCache;
 
 	bool m_loaded = false;
 };
 
+/// a Java binary that might be worth checking
+struct JavaCandidate
+{
+	QString path;
+	JavaCheckCache::Key key;
+};
+
 class JavaListLoadTask : public Task
 {
 	Q_OBJECT
@@ -89,8 +105,23 @@ public slots:
 	void javaCheckerFinished(QList<JavaCheckResult> results);
 	void checkerProgress(int current, int total);
 
+private slots:
+	void scanFinished();
+
+private:
+	/// finds the candidates and looks at their binaries, runs in a worker thread
+	static QList<JavaCandidate> scan(QStringList extraDirs);
+	void finish();
+
 protected:
 	std::shared_ptr<JavaCheckerJob> m_job;
 	JavaVersionList *m_list;
 	JavaVersion *m_currentRecommended;
+	QFutureWatcher<QList<JavaCandidate>> m_scanner;
+	/// in the order they should be listed
+	QList<JavaCandidate> m_candidates;
+	/// check results, by real path of the binary
+	QHash<QString, JavaCheckResult> m_results;
+	/// binaries being checked, by checker id
+	QList<JavaCheckCache::Key> m_checking;
 };
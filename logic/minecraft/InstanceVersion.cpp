@@ -23,6 +23,7 @@
 #include "logic/minecraft/InstanceVersion.h"
 #include "logic/minecraft/VersionBuilder.h"
 #include "logic/OneSixInstance.h"
+#include "logic/StringPool.h"
 
 InstanceVersion::InstanceVersion(OneSixInstance *instance, QObject *parent)
 	: QAbstractListModel(parent), m_instance(instance)
@@ -32,15 +33,34 @@ InstanceVersion::InstanceVersion(OneSixInstance *instance, QObject *parent)
 
 void InstanceVersion::reload(const QStringList &external)
 {
+	// reading and hashing the files is a lot cheaper than parsing and applying them
+	auto fingerprint = VersionBuilder::fingerprint(m_instance, external);
+	if (!m_fingerprint.isEmpty() && fingerprint == m_fingerprint)
+	{
+		return;
+	}
+
+	m_fingerprint.clear();
 	m_externalPatches = external;
 	beginResetModel();
 	VersionBuilder::build(this, m_instance, m_externalPatches);
 	reapply(true);
 	endResetModel();
+	// only remembered once the build succeeded
+	m_fingerprint = fingerprint;
+
+	// the previous build may have been the last user of some strings
+	StringPool::prune();
+	auto poolStats = StringPool::stats();
+	QLOG_DEBUG() << "String pool:" << poolStats.strings << "strings," << poolStats.bytes
+				 << "bytes," << poolStats.hits << "of" << poolStats.lookups << "lookups shared,"
+				 << poolStats.savedBytes << "bytes saved";
 }
 
 void InstanceVersion::clear()
 {
+	// whatever happens next, the current state no longer matches the files
+	m_fingerprint.clear();
 	id.clear();
 	m_updateTimeString.clear();
 	m_updateTime = QDateTime();
@@ -54,6 +74,8 @@ void InstanceVersion::clear()
 	mainClass.clear();
 	appletClass.clear();
 	libraries.clear();
+	m_activeNormalLibs.clear();
+	m_activeNativeLibs.clear();
 	tweakers.clear();
 	jarMods.clear();
 	traits.clear();
@@ -257,39 +279,6 @@ bool InstanceVersion::removeDeprecatedVersionFiles()
 	return true;
 }
 
-QList<std::shared_ptr<OneSixLibrary> > InstanceVersion::getActiveNormalLibs()
-{
-	QList<std::shared_ptr<OneSixLibrary> > output;
-	for (auto lib : libraries)
-	{
-		if (lib->isActive() && !lib->isNative())
-		{
-			for (auto other : output)
-			{
-				if (other->rawName() == lib->rawName())
-				{
-					QLOG_WARN() << "Multiple libraries with name" << lib->rawName() << "in library list!";
-					continue;
-				}
-			}
-			output.append(lib);
-		}
-	}
-	return output;
-}
-QList<std::shared_ptr<OneSixLibrary> > InstanceVersion::getActiveNativeLibs()
-{
-	QList<std::shared_ptr<OneSixLibrary> > output;
-	for (auto lib : libraries)
-	{
-		if (lib->isActive() && lib->isNative())
-		{
-			output.append(lib);
-		}
-	}
-	return output;
-}
-
 std::shared_ptr<InstanceVersion> InstanceVersion::fromJson(const QJsonObject &obj)
 {
 	std::shared_ptr<InstanceVersion> version(new InstanceVersion(0));
@@ -463,6 +452,29 @@ void InstanceVersion::finalize()
 	};
 	finalizeArguments(vanillaMinecraftArguments, vanillaProcessArguments);
 	finalizeArguments(minecraftArguments, processArguments);
+
+	// the rules only depend on the platform, so they are evaluated once here
+	m_activeNormalLibs.clear();
+	m_activeNativeLibs.clear();
+	QSet<QString> normalNames;
+	for (auto lib : libraries)
+	{
+		lib->finalize();
+		if (!lib->isActive())
+			continue;
+		if (lib->isNative())
+		{
+			m_activeNativeLibs.append(lib);
+			continue;
+		}
+		const QString name = lib->rawName();
+		if (normalNames.contains(name))
+		{
+			QLOG_WARN() << "Multiple libraries with name" << name << "in library list!";
+		}
+		normalNames.insert(name);
+		m_activeNormalLibs.append(lib);
+	}
 }
 
 void InstanceVersion::installJarMods(QStringList selectedFiles)
@@ -19,6 +19,7 @@
 
 #include <QString>
 #include <QList>
+#include <QVector>
 #include <memory>
 
 #include "OneSixLibrary.h"
@@ -80,8 +81,15 @@ slots:
 	bool remove(const QString id);
 
 public:
-	QList<std::shared_ptr<OneSixLibrary>> getActiveNormalLibs();
-	QList<std::shared_ptr<OneSixLibrary>> getActiveNativeLibs();
+	/// libraries active on the current platform, sorted out once by finalize()
+	const QVector<OneSixLibraryPtr> &getActiveNormalLibs() const
+	{
+		return m_activeNormalLibs;
+	}
+	const QVector<OneSixLibraryPtr> &getActiveNativeLibs() const
+	{
+		return m_activeNativeLibs;
+	}
 
 	static std::shared_ptr<InstanceVersion> fromJson(const QJsonObject &obj);
 
@@ -179,6 +187,10 @@ public:
 private:
 	QStringList m_externalPatches;
 	OneSixInstance *m_instance;
+	/// VersionBuilder::fingerprint() of the files this version was built from, if unchanged since
+	QByteArray m_fingerprint;
+	QVector<OneSixLibraryPtr> m_activeNormalLibs;
+	QVector<OneSixLibraryPtr> m_activeNativeLibs;
 	void saveCurrentOrder() const;
 	int getFreeOrderNumber();
 };
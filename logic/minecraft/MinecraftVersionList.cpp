@@ -30,6 +30,7 @@
 #include <pathutils.h>
 
 static const char * localVersionCache = "versions/versions.dat";
+static const char * remoteVersionCache = "versions/versions-remote.dat";
 
 class ListLoadError : public MMCError
 {
@@ -352,37 +353,94 @@ MCVListLoadTask::MCVListLoadTask(MinecraftVersionList *vlist)
 {
 	m_list = vlist;
 	m_currentStable = NULL;
-	vlistReply = nullptr;
 }
 
 void MCVListLoadTask::executeTask()
 {
 	setStatus(tr("Loading instance version list..."));
-	auto worker = MMC->qnam();
-	vlistReply = worker->get(QNetworkRequest(
-		QUrl("http://" + URLConstants::AWS_DOWNLOAD_VERSIONS + "versions.json")));
-	connect(vlistReply, SIGNAL(finished()), this, SLOT(list_downloaded()));
+	auto job = new NetJob("Version index");
+	listEntry = MMC->metacache()->resolveEntry("versions", "versions.json");
+
+	// verify by poking the server. If nothing changed, this is a 304 and the file stays.
+	listEntry->stale = true;
+
+	job->addNetAction(listDownload = CacheDownload::make(
+						  QUrl("http://" + URLConstants::AWS_DOWNLOAD_VERSIONS + "versions.json"),
+						  listEntry));
+
+	listJob.reset(job);
+	// not the download's own failed(), the job retries failed downloads
+	connect(listJob.get(), SIGNAL(failed()), SLOT(list_failed()));
+	connect(listJob.get(), SIGNAL(succeeded()), SLOT(list_downloaded()));
+	connect(listJob.get(), SIGNAL(progress(qint64, qint64)), SIGNAL(progress(qint64, qint64)));
+	listJob->start();
 }
 
-void MCVListLoadTask::list_downloaded()
+void MCVListLoadTask::list_failed()
 {
-	if (vlistReply->error() != QNetworkReply::NoError)
-	{
-		vlistReply->deleteLater();
-		emitFailed("Failed to load Minecraft main version list" + vlistReply->errorString());
+	emitFailed(tr("Failed to load Minecraft main version list."));
+}
+
+/*
+ * The parsed remote list is kept next to the downloaded one, in binary form, tagged with
+ * the MD5 of the file it came from. As long as the server keeps saying the list didn't
+ * change, the JSON never has to be parsed again.
+ */
+static QJsonDocument readParsedRemoteList(const QString &md5)
+{
+	if (md5.isEmpty())
+		return QJsonDocument();
+	QFile cacheFile(remoteVersionCache);
+	if (!cacheFile.open(QIODevice::ReadOnly))
+		return QJsonDocument();
+	QJsonDocument doc = QJsonDocument::fromBinaryData(cacheFile.readAll());
+	if (!doc.isObject() || doc.object().value("md5").toString() != md5)
+		return QJsonDocument();
+	return doc;
+}
+
+static void writeParsedRemoteList(QJsonObject root, const QString &md5)
+{
+	if (md5.isEmpty() || !ensureFilePathExists(remoteVersionCache))
 		return;
+	root.insert("md5", md5);
+	QByteArray data = QJsonDocument(root).toBinaryData();
+	QSaveFile cacheFile(remoteVersionCache);
+	if (!cacheFile.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+		cacheFile.write(data) != data.size() || !cacheFile.commit())
+	{
+		QLOG_WARN() << "Couldn't write the parsed minecraft version list to"
+					<< remoteVersionCache;
 	}
+}
 
-	auto data = vlistReply->readAll();
-	vlistReply->deleteLater();
+void MCVListLoadTask::list_downloaded()
+{
+	const QString md5 = listEntry->md5sum;
+	const QString filename = listDownload->getTargetFilepath();
+	listDownload.reset();
+	listEntry.reset();
 	try
 	{
-		QJsonParseError jsonError;
-		QJsonDocument jsonDoc = QJsonDocument::fromJson(data, &jsonError);
-		if (jsonError.error != QJsonParseError::NoError)
+		QJsonDocument jsonDoc = readParsedRemoteList(md5);
+		if (jsonDoc.isNull())
 		{
-			throw ListLoadError(
-				tr("Error parsing version list JSON: %1").arg(jsonError.errorString()));
+			QFile listFile(filename);
+			if (!listFile.open(QIODevice::ReadOnly))
+			{
+				throw ListLoadError(tr("Failed to open the Minecraft main version list."));
+			}
+			QJsonParseError jsonError;
+			jsonDoc = QJsonDocument::fromJson(listFile.readAll(), &jsonError);
+			if (jsonError.error != QJsonParseError::NoError)
+			{
+				throw ListLoadError(
+					tr("Error parsing version list JSON: %1").arg(jsonError.errorString()));
+			}
+			if (jsonDoc.isObject())
+			{
+				writeParsedRemoteList(jsonDoc.object(), md5);
+			}
 		}
 		m_list->loadMojangList(jsonDoc, Remote);
 	}
@@ -406,23 +464,40 @@ MCVListVersionUpdateTask::MCVListVersionUpdateTask(MinecraftVersionList *vlist,
 
 void MCVListVersionUpdateTask::executeTask()
 {
-	QString urlstr = "http://" + URLConstants::AWS_DOWNLOAD_VERSIONS + versionToUpdate + "/" +
-					 versionToUpdate + ".json";
+	QString localPath = versionToUpdate + "/" + versionToUpdate + ".json";
+	QString urlstr = "http://" + URLConstants::AWS_DOWNLOAD_VERSIONS + localPath;
+	auto entry = MMC->metacache()->resolveEntry("versions", localPath);
+	// a conditional request, the file is only downloaded again if it changed
+	entry->stale = true;
+
 	auto job = new NetJob("Version index");
-	job->addNetAction(ByteArrayDownload::make(QUrl(urlstr)));
+	job->addNetAction(specificVersionDownload = CacheDownload::make(QUrl(urlstr), entry));
 	specificVersionDownloadJob.reset(job);
+	connect(specificVersionDownloadJob.get(), SIGNAL(failed()), SLOT(json_failed()));
 	connect(specificVersionDownloadJob.get(), SIGNAL(succeeded()), SLOT(json_downloaded()));
-	connect(specificVersionDownloadJob.get(), SIGNAL(failed(QString)), SIGNAL(failed(QString)));
 	connect(specificVersionDownloadJob.get(), SIGNAL(progress(qint64, qint64)),
 			SIGNAL(progress(qint64, qint64)));
 	specificVersionDownloadJob->start();
 }
 
+void MCVListVersionUpdateTask::json_failed()
+{
+	emitFailed(tr("Failed to download the version file for %1.").arg(versionToUpdate));
+}
+
 void MCVListVersionUpdateTask::json_downloaded()
 {
-	NetActionPtr DlJob = specificVersionDownloadJob->first();
-	auto data = std::dynamic_pointer_cast<ByteArrayDownload>(DlJob)->m_data;
-	specificVersionDownloadJob.reset();
+	QByteArray data;
+	{
+		QFile versionFile(specificVersionDownload->getTargetFilepath());
+		specificVersionDownload.reset();
+		if (!versionFile.open(QIODevice::ReadOnly))
+		{
+			emitFailed(tr("Failed to open the downloaded version file."));
+			return;
+		}
+		data = versionFile.readAll();
+	}
 
 	QJsonParseError jsonError;
 	QJsonDocument jsonDoc = QJsonDocument::fromJson(data, &jsonError);
@@ -465,7 +540,6 @@ void MCVListVersionUpdateTask::json_downloaded()
 	// now dump the file to disk
 	auto doc = file->toJson(false);
 	auto newdata = doc.toBinaryData();
-	QLOG_INFO() << newdata;
 	QString targetPath = "versions/" + versionToUpdate + "/" + versionToUpdate + ".dat";
 	ensureFilePathExists(targetPath);
 	QSaveFile vfile1(targetPath);
@@ -23,10 +23,10 @@
 #include "logic/tasks/Task.h"
 #include "logic/minecraft/MinecraftVersion.h"
 #include <logic/net/NetJob.h>
+#include <logic/net/CacheDownload.h>
 
 class MCVListLoadTask;
 class MCVListVersionUpdateTask;
-class QNetworkReply;
 
 class MinecraftVersionList : public BaseVersionList
 {
@@ -81,9 +81,12 @@ public:
 protected
 slots:
 	void list_downloaded();
+	void list_failed();
 
 protected:
-	QNetworkReply *vlistReply;
+	NetJobPtr listJob;
+	CacheDownloadPtr listDownload;
+	MetaEntryPtr listEntry;
 	MinecraftVersionList *m_list;
 	MinecraftVersion *m_currentStable;
 };
@@ -100,9 +103,11 @@ public:
 protected
 slots:
 	void json_downloaded();
+	void json_failed();
 
 protected:
 	NetJobPtr specificVersionDownloadJob;
+	CacheDownloadPtr specificVersionDownload;
 	QString versionToUpdate;
 	MinecraftVersionList *m_list;
 };
@@ -25,7 +25,7 @@ RawLibraryPtr RawLibrary::fromJson(const QJsonObject &libObj, const QString &fil
 			return false;
 		}
 
-		variable = val.toString();
+		variable = StringPool::intern(val.toString());
 		return true;
 	};
 
@@ -39,7 +39,7 @@ RawLibraryPtr RawLibrary::fromJson(const QJsonObject &libObj, const QString &fil
 		auto extractObj = ensureObject(libObj.value("extract"));
 		for (auto excludeVal : ensureArray(extractObj.value("exclude")))
 		{
-			out->extract_excludes.append(ensureString(excludeVal));
+			out->extract_excludes.append(StringPool::intern(ensureString(excludeVal)));
 		}
 	}
 	if (libObj.contains("natives"))
@@ -54,7 +54,7 @@ RawLibraryPtr RawLibrary::fromJson(const QJsonObject &libObj, const QString &fil
 			OpSys opSys = OpSys_fromString(it.key());
 			if (opSys != Os_Other)
 			{
-				out->m_native_classifiers[opSys] = it.value().toString();
+				out->m_native_classifiers[opSys] = StringPool::intern(it.value().toString());
 			}
 		}
 	}
@@ -259,8 +259,19 @@ bool RawLibrary::isActive() const
 	return result;
 }
 
+void RawLibrary::finalize()
+{
+	m_storage_path.clear();
+	m_storage_path = StringPool::intern(storagePath());
+}
+
 QString RawLibrary::storagePath() const
 {
+	if (!m_storage_path.isEmpty())
+	{
+		return m_storage_path;
+	}
+
 	// non-native? use only the gradle specifier
 	if (!isNative())
 	{
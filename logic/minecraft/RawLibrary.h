@@ -11,6 +11,7 @@
 #include "logic/minecraft/OpSys.h"
 #include "GradleSpecifier.h"
 #include "logic/net/URLConstants.h"
+#include "logic/StringPool.h"
 
 class RawLibrary;
 typedef std::shared_ptr<RawLibrary> RawLibraryPtr;
@@ -37,11 +38,13 @@ public: /* methods */
 	void setRawName(const GradleSpecifier & spec)
 	{
 		m_name = spec;
+		m_storage_path.clear();
 	}
 
 	void setClassifier(const QString & spec)
 	{
 		m_name.setClassifier(spec);
+		m_storage_path.clear();
 	}
 	
 	/// returns the full group and artifact prefix
@@ -71,7 +74,7 @@ public: /* methods */
 	/// Set the url base for downloads
 	void setBaseUrl(const QString &base_url)
 	{
-		m_base_url = base_url;
+		m_base_url = StringPool::intern(base_url);
 	}
 
 	/// List of files this library describes. Required because of platform-specificness of native libs
@@ -82,7 +85,7 @@ public: /* methods */
 
 	void setAbsoluteUrl(const QString &absolute_url)
 	{
-		m_absolute_url = absolute_url;
+		m_absolute_url = StringPool::intern(absolute_url);
 	}
 
 	QString absoluteUrl() const
@@ -92,7 +95,7 @@ public: /* methods */
 
 	void setHint(const QString &hint)
 	{
-		m_hint = hint;
+		m_hint = StringPool::intern(hint);
 	}
 
 	QString hint() const
@@ -115,11 +118,14 @@ public: /* methods */
 	/// Get the relative path where the library should be saved
 	QString storagePath() const;
 
+	/// work out (and pool) the storage path once, the library shouldn't change after this
+	void finalize();
+
 
 protected: /* data */
 	/// the basic gradle dependency specifier.
 	GradleSpecifier m_name;
-	/// where to store the lib locally
+	/// where to store the lib locally, set by finalize()
 	QString m_storage_path;
 	/// is this lib actually active on the current OS?
 	bool m_is_active = false;
@@ -22,6 +22,8 @@
 #include <QMessageBox>
 #include <QObject>
 #include <QDir>
+#include <QCryptographicHash>
+#include <QDateTime>
 #include <qresource.h>
 #include <modutils.h>
 
@@ -53,6 +55,56 @@ void VersionBuilder::build(InstanceVersion *version, OneSixInstance *instance,
 	builder.buildInternal();
 }
 
+QByteArray VersionBuilder::fingerprint(OneSixInstance *instance, const QStringList &external)
+{
+	QCryptographicHash hash(QCryptographicHash::Md5);
+	auto addFile = [&](const QFileInfo &info)
+	{
+		hash.addData(info.absoluteFilePath().toUtf8());
+		if (!info.exists())
+			return;
+		hash.addData(QByteArray::number(info.size()));
+		hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+		// mtimes can be too coarse to notice quick successive edits, so hash the contents too
+		QFile file(info.absoluteFilePath());
+		if (file.open(QFile::ReadOnly))
+			hash.addData(file.readAll());
+	};
+
+	for (auto fileName : external)
+	{
+		addFile(QFileInfo(fileName));
+	}
+	QDir root(instance->instanceRoot());
+	addFile(QFileInfo(root.absoluteFilePath("custom.json")));
+	addFile(QFileInfo(root.absoluteFilePath("version.json")));
+	addFile(QFileInfo(root.absoluteFilePath("order.json")));
+	QDir patches(root.absoluteFilePath("patches/"));
+	for (auto info : patches.entryInfoList(QStringList() << "*.json", QDir::Files, QDir::Name))
+	{
+		addFile(info);
+	}
+
+	// the Minecraft version comes either from its local file or from the version list
+	const QString versionId = instance->intendedVersionId();
+	hash.addData(versionId.toUtf8());
+	addFile(QFileInfo(QString("versions/%1/%1.dat").arg(versionId)));
+	auto mcversion = std::dynamic_pointer_cast<MinecraftVersion>(
+		MMC->minecraftlist()->findVersion(versionId));
+	if (mcversion)
+	{
+		hash.addData(QByteArray::number(int(mcversion->m_versionSource)));
+		hash.addData(mcversion->m_updateTimeString.toUtf8());
+		hash.addData(mcversion->m_mainClass.toUtf8());
+		hash.addData(mcversion->m_appletClass.toUtf8());
+		hash.addData(mcversion->m_processArguments.toUtf8());
+	}
+
+	// finalize() depends on the date, of all things
+	hash.addData(QDate::currentDate().toString(Qt::ISODate).toUtf8());
+	return hash.result();
+}
+
 void VersionBuilder::readJsonAndApplyToVersion(InstanceVersion *version, const QJsonObject &obj)
 {
 	VersionBuilder builder;
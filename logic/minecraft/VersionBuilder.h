@@ -31,6 +31,12 @@ class VersionBuilder
 	VersionBuilder();
 public:
 	static void build(InstanceVersion *version, OneSixInstance *instance, const QStringList &external);
+	/**
+	 * @brief a hash of everything build() would read for the instance
+	 * If it didn't change, building again would produce the same version.
+	 * Only compared against the last build in memory, nothing is kept across restarts.
+	 */
+	static QByteArray fingerprint(OneSixInstance *instance, const QStringList &external);
 	static void readJsonAndApplyToVersion(InstanceVersion *version, const QJsonObject &obj);
 	static VersionFilePtr parseJsonFile(const QFileInfo &fileInfo, const bool requireOrder, bool isFTB = false);
 	static VersionFilePtr parseBinaryJsonFile(const QFileInfo &fileInfo);
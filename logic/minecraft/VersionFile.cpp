@@ -1,7 +1,11 @@
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QHash>
+#include <QVector>
 #include <modutils.h>
 
+#include <climits>
+
 #include "logger/QsLog.h"
 
 #include "logic/minecraft/VersionFile.h"
@@ -17,20 +21,102 @@ using namespace MMCJson;
 
 #define CURRENT_MINIMUM_LAUNCHER_VERSION 14
 
-int findLibraryByName(QList<OneSixLibraryPtr> haystack, const GradleSpecifier &needle)
+namespace
+{
+/**
+ * The libraries of a version while a version file is applied to it.
+ *
+ * Libraries are looked up by group and artifact through a hash. Prepending, appending and
+ * removing don't move anything around, the final list is put together once at the end.
+ */
+class LibraryMerger
 {
-	int retval = -1;
-	for (int i = 0; i < haystack.size(); ++i)
+public:
+	enum
+	{
+		NotFound = INT_MIN,
+		Ambiguous
+	};
+
+	explicit LibraryMerger(const QList<OneSixLibraryPtr> &libraries)
 	{
-		if (haystack.at(i)->rawName().matchName(needle))
+		m_body.reserve(libraries.size());
+		for (auto &library : libraries)
 		{
-			// only one is allowed.
-			if (retval != -1)
-				return -1;
-			retval = i;
+			append(library);
 		}
 	}
-	return retval;
+
+	/// location of the only library with the same group and artifact, or NotFound
+	int find(const GradleSpecifier &name) const
+	{
+		// only one is allowed.
+		const int location = m_byName.value(name.artifactPrefix(), NotFound);
+		return location == Ambiguous ? NotFound : location;
+	}
+	OneSixLibraryPtr &at(int location)
+	{
+		// prepended libraries have negative locations
+		return location >= 0 ? m_body[location] : m_front[-location - 1];
+	}
+
+	void append(OneSixLibraryPtr library)
+	{
+		m_body.append(library);
+		addName(library->artifactPrefix(), m_body.size() - 1);
+	}
+	void prepend(OneSixLibraryPtr library)
+	{
+		m_front.append(library);
+		addName(library->artifactPrefix(), -m_front.size());
+	}
+	void replace(int location, OneSixLibraryPtr library)
+	{
+		m_byName.remove(at(location)->artifactPrefix());
+		at(location) = library;
+		addName(library->artifactPrefix(), location);
+	}
+	void remove(int location)
+	{
+		m_byName.remove(at(location)->artifactPrefix());
+		at(location).reset();
+	}
+
+	QList<OneSixLibraryPtr> assemble() const
+	{
+		QList<OneSixLibraryPtr> result;
+		result.reserve(m_front.size() + m_body.size());
+		for (int i = m_front.size() - 1; i >= 0; i--)
+		{
+			if (m_front[i])
+				result.append(m_front[i]);
+		}
+		for (auto &library : m_body)
+		{
+			if (library)
+				result.append(library);
+		}
+		return result;
+	}
+
+private:
+	void addName(const QString &prefix, int location)
+	{
+		auto it = m_byName.find(prefix);
+		if (it == m_byName.end())
+			m_byName.insert(prefix, location);
+		else
+			it.value() = Ambiguous;
+	}
+
+private:
+	/// group:artifact -> location, or Ambiguous if there is more than one
+	QHash<QString, int> m_byName;
+	/// the original libraries, then the appended ones. Removed ones are null.
+	QVector<OneSixLibraryPtr> m_body;
+	/// prepended libraries, in the order they were prepended. Removed ones are null.
+	QVector<OneSixLibraryPtr> m_front;
+};
 }
 
 VersionFilePtr VersionFile::fromJson(const QJsonDocument &doc, const QString &filename,
@@ -374,6 +460,7 @@ void VersionFile::applyTo(InstanceVersion *version)
 		}
 		version->libraries = libs;
 	}
+	LibraryMerger libraries(version->libraries);
 	for (auto addedLibrary : addLibs)
 	{
 		switch (addedLibrary->insertType)
@@ -381,10 +468,10 @@ void VersionFile::applyTo(InstanceVersion *version)
 		case RawLibrary::Apply:
 		{
 			// QLOG_INFO() << "Applying lib " << lib->name;
-			int index = findLibraryByName(version->libraries, addedLibrary->rawName());
-			if (index >= 0)
+			int index = libraries.find(addedLibrary->rawName());
+			if (index != LibraryMerger::NotFound)
 			{
-				auto existingLibrary = version->libraries[index];
+				auto existingLibrary = libraries.at(index);
 				if (!addedLibrary->m_base_url.isNull())
 				{
 					existingLibrary->setBaseUrl(addedLibrary->m_base_url);
@@ -420,23 +507,23 @@ void VersionFile::applyTo(InstanceVersion *version)
 		case RawLibrary::Prepend:
 		{
 			// find the library by name.
-			const int index = findLibraryByName(version->libraries, addedLibrary->rawName());
+			const int index = libraries.find(addedLibrary->rawName());
 			// library not found? just add it.
-			if (index < 0)
+			if (index == LibraryMerger::NotFound)
 			{
 				if (addedLibrary->insertType == RawLibrary::Append)
 				{
-					version->libraries.append(OneSixLibrary::fromRawLibrary(addedLibrary));
+					libraries.append(OneSixLibrary::fromRawLibrary(addedLibrary));
 				}
 				else
 				{
-					version->libraries.prepend(OneSixLibrary::fromRawLibrary(addedLibrary));
+					libraries.prepend(OneSixLibrary::fromRawLibrary(addedLibrary));
 				}
 				break;
 			}
 
 			// otherwise apply differences, if allowed
-			auto existingLibrary = version->libraries.at(index);
+			auto existingLibrary = libraries.at(index);
 			const Util::Version addedVersion = addedLibrary->version();
 			const Util::Version existingVersion = existingLibrary->version();
 			// if the existing version is a hard dependency we can either use it or
@@ -464,7 +551,7 @@ void VersionFile::applyTo(InstanceVersion *version)
 				if (addedVersion > existingVersion)
 				{
 					auto library = OneSixLibrary::fromRawLibrary(addedLibrary);
-					version->libraries.replace(index, library);
+					libraries.replace(index, library);
 				}
 				else
 				{
@@ -493,10 +580,10 @@ void VersionFile::applyTo(InstanceVersion *version)
 				toReplace = addedLibrary->insertData;
 			}
 			// QLOG_INFO() << "Replacing lib " << toReplace << " with " << lib->name;
-			int index = findLibraryByName(version->libraries, toReplace);
-			if (index >= 0)
+			int index = libraries.find(toReplace);
+			if (index != LibraryMerger::NotFound)
 			{
-				version->libraries.replace(index, OneSixLibrary::fromRawLibrary(addedLibrary));
+				libraries.replace(index, OneSixLibrary::fromRawLibrary(addedLibrary));
 			}
 			else
 			{
@@ -508,15 +595,16 @@ void VersionFile::applyTo(InstanceVersion *version)
 	}
 	for (auto lib : removeLibs)
 	{
-		int index = findLibraryByName(version->libraries, lib);
-		if (index >= 0)
+		int index = libraries.find(lib);
+		if (index != LibraryMerger::NotFound)
 		{
 			// QLOG_INFO() << "Removing lib " << lib;
-			version->libraries.removeAt(index);
+			libraries.remove(index);
 		}
 		else
 		{
 			QLOG_WARN() << "Couldn't find" << lib << "(skipping)";
 		}
 	}
+	version->libraries = libraries.assemble();
 }
@@ -0,0 +1,94 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThumbnailCache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QSaveFile>
+#include <QUrl>
+
+#include <pathutils.h>
+
+static QString sizeFolder(int size)
+{
+	if (size <= 128)
+		return "normal";
+	if (size <= 256)
+		return "large";
+	if (size <= 512)
+		return "x-large";
+	return "xx-large";
+}
+
+static QString sourceUri(const QString &sourcePath)
+{
+	return QUrl::fromLocalFile(QFileInfo(sourcePath).absoluteFilePath()).toString(
+		QUrl::FullyEncoded);
+}
+
+static QString sourceMTime(const QString &sourcePath)
+{
+	return QString::number(QFileInfo(sourcePath).lastModified().toMSecsSinceEpoch() / 1000);
+}
+
+ThumbnailCache::ThumbnailCache(const QString &root) : m_root(root)
+{
+}
+
+QString ThumbnailCache::thumbnailPath(const QString &sourcePath, int size) const
+{
+	const QByteArray hash =
+		QCryptographicHash::hash(sourceUri(sourcePath).toUtf8(), QCryptographicHash::Md5);
+	return PathCombine(m_root, sizeFolder(size), QString::fromLatin1(hash.toHex()) + ".png");
+}
+
+QImage ThumbnailCache::load(const QString &sourcePath, int size) const
+{
+	QImageReader reader(thumbnailPath(sourcePath, size), "png");
+	// the text chunks come before the image data, so outdated files aren't decoded
+	if (reader.text("Thumb::URI") != sourceUri(sourcePath) ||
+		reader.text("Thumb::MTime") != sourceMTime(sourcePath))
+	{
+		return QImage();
+	}
+	return reader.read();
+}
+
+bool ThumbnailCache::store(const QString &sourcePath, int size, QImage thumbnail) const
+{
+	const QString path = thumbnailPath(sourcePath, size);
+	if (!ensureFilePathExists(path))
+		return false;
+
+	thumbnail.setText("Thumb::URI", sourceUri(sourcePath));
+	thumbnail.setText("Thumb::MTime", sourceMTime(sourcePath));
+	thumbnail.setText("Software", "MultiMC");
+
+	// readers never see half written thumbnails
+	QSaveFile file(path);
+	if (!file.open(QIODevice::WriteOnly))
+		return false;
+	QImageWriter writer(&file, "png");
+	if (!writer.write(thumbnail))
+	{
+		file.cancelWriting();
+		return false;
+	}
+	return file.commit();
+}
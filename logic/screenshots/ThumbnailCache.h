@@ -0,0 +1,46 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <QString>
+#include <QImage>
+
+/**
+ * Thumbnails kept on disk, laid out like the freedesktop.org thumbnail cache.
+ *
+ * There is a folder for each size ("normal" is 128, "large" is 256 pixels...) with a PNG for
+ * each thumbnail, named after the MD5 of the source file URI. The URI and modification time
+ * of the source file are stored in the PNG, so outdated thumbnails are never used.
+ *
+ * Doesn't keep any state besides the root folder, so it can be used from any thread.
+ */
+class ThumbnailCache
+{
+public:
+	explicit ThumbnailCache(const QString &root);
+
+	/// where the thumbnail of a file would be. Sizes are rounded up to the next folder.
+	QString thumbnailPath(const QString &sourcePath, int size) const;
+
+	/// the thumbnail of a file, or a null image if there is none or it is outdated
+	QImage load(const QString &sourcePath, int size) const;
+
+	/// store the thumbnail of a file, replacing the old one
+	bool store(const QString &sourcePath, int size, QImage thumbnail) const;
+
+private:
+	QString m_root;
+};
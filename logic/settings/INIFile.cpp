@@ -16,60 +16,110 @@
 #include "logic/settings/INIFile.h"
 
 #include <QFile>
-#include <QTextStream>
-#include <QStringList>
 #include <QSaveFile>
 #include <QDebug>
 
+#include <cstring>
+
 INIFile::INIFile()
 {
 }
 
-QString INIFile::unescape(QString orig)
+// the escaped characters are all ASCII, which never shows up inside a multibyte UTF-8
+// sequence, so escaping can work on the raw bytes. '#' would start a comment otherwise.
+static inline bool needsEscape(char c)
+{
+	return c == '\n' || c == '\t' || c == '\\' || c == '#';
+}
+
+static void escapeInto(QByteArray &out, const QByteArray &value)
 {
-	QString out;
-	QChar prev = 0;
-	for(auto c: orig)
+	const char *pos = value.constData();
+	const char *end = pos + value.size();
+	while (pos < end)
 	{
-		if(prev == '\\')
-		{
-			if(c == 'n')
-				out += '\n';
-			else if (c == 't')
-				out += '\t';
-			else
-				out += c;
-			prev = 0;
-		}
-		else
+		// copy everything up to the next character that needs escaping in one go
+		const char *run = pos;
+		while (pos < end && !needsEscape(*pos))
+			pos++;
+		out.append(run, pos - run);
+		if (pos == end)
+			break;
+		out.append('\\');
+		out.append(*pos == '\n' ? 'n' : *pos == '\t' ? 't' : *pos);
+		pos++;
+	}
+}
+
+static void unescapeInto(QByteArray &out, const char *pos, const char *end)
+{
+	while (pos < end)
+	{
+		const char *backslash = (const char *)memchr(pos, '\\', end - pos);
+		if (!backslash)
 		{
-			if(c == '\\')
-			{
-				prev = c;
-				continue;
-			}
-			out += c;
-			prev = 0;
+			out.append(pos, end - pos);
+			return;
 		}
+		out.append(pos, backslash - pos);
+		pos = backslash + 1;
+		// a lone backslash at the end is dropped
+		if (pos == end)
+			return;
+		out.append(*pos == 'n' ? '\n' : *pos == 't' ? '\t' : *pos);
+		pos++;
 	}
-	return out;
 }
 
-QString INIFile::escape(QString orig)
+static inline bool isSpace(char c)
 {
-	QString out;
-	for(auto c: orig)
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/// the first '#' that isn't escaped, or end
+static const char *findComment(const char *begin, const char *end)
+{
+	const char *pos = begin;
+	while ((pos = (const char *)memchr(pos, '#', end - pos)))
 	{
-		if(c == '\n')
-			out += "\\n";
-		else if (c == '\t')
-			out += "\\t";
-		else if(c == '\\')
-			out += "\\\\";
-		else
-			out += c;
+		int backslashes = 0;
+		for (const char *c = pos; c > begin && c[-1] == '\\'; c--)
+			backslashes++;
+		if (backslashes % 2 == 0)
+			return pos;
+		pos++;
 	}
-	return out;
+	return end;
+}
+
+static void trim(const char *&begin, const char *&end)
+{
+	while (begin < end && isSpace(*begin))
+		begin++;
+	while (end > begin && isSpace(end[-1]))
+		end--;
+}
+
+QString INIFile::unescape(QString orig)
+{
+	if (!orig.contains('\\'))
+		return orig;
+	const QByteArray in = orig.toUtf8();
+	QByteArray out;
+	out.reserve(in.size());
+	unescapeInto(out, in.constData(), in.constData() + in.size());
+	return QString::fromUtf8(out);
+}
+
+QString INIFile::escape(QString orig)
+{
+	const QByteArray in = orig.toUtf8();
+	QByteArray out;
+	out.reserve(in.size() + in.size() / 8);
+	escapeInto(out, in);
+	if (out.size() == in.size())
+		return orig;
+	return QString::fromUtf8(out);
 }
 
 bool INIFile::saveFile(QString fileName)
@@ -81,14 +131,14 @@ bool INIFile::saveFile(QString fileName)
 		return false;
 	}
 	QByteArray outArray;
+	// configs are small, guess high enough to never have to grow
+	outArray.reserve(size() * 64);
 
-	for (Iterator iter = begin(); iter != end(); iter++)
+	for (ConstIterator iter = constBegin(); iter != constEnd(); iter++)
 	{
-		QString value = iter.value().toString();
-		value = escape(value);
 		outArray.append(iter.key().toUtf8());
 		outArray.append('=');
-		outArray.append(iter.value().toString().toUtf8());
+		escapeInto(outArray, iter.value().toString().toUtf8());
 		outArray.append('\n');
 	}
 	if(file.write(outArray) != outArray.size())
@@ -118,26 +168,39 @@ bool INIFile::loadFile(QString fileName)
 }
 bool INIFile::loadFile(QByteArray file)
 {
-	QTextStream in(file);
-	in.setCodec("UTF-8");
-
-	QStringList lines = in.readAll().split('\n');
-	for (int i = 0; i < lines.count(); i++)
+	const char *pos = file.constData();
+	const char *end = pos + file.size();
+	// skip the UTF-8 byte order mark
+	if (file.startsWith("\xEF\xBB\xBF"))
+		pos += 3;
+
+	QByteArray value;
+	value.reserve(256);
+	while (pos < end)
 	{
-		QString &lineRaw = lines[i];
-		// Ignore comments.
-		QString line = lineRaw.left(lineRaw.indexOf('#')).trimmed();
+		const char *lineEnd = (const char *)memchr(pos, '\n', end - pos);
+		if (!lineEnd)
+			lineEnd = end;
 
-		int eqPos = line.indexOf('=');
-		if (eqPos == -1)
-			continue;
-		QString key = line.left(eqPos).trimmed();
-		QString valueStr = line.right(line.length() - eqPos - 1).trimmed();
-
-		valueStr = unescape(valueStr);
+		// Ignore comments.
+		const char *contentEnd = findComment(pos, lineEnd);
 
-		QVariant value(valueStr);
-		this->operator[](key) = value;
+		const char *eq = (const char *)memchr(pos, '=', contentEnd - pos);
+		if (eq)
+		{
+			const char *keyBegin = pos;
+			const char *keyEnd = eq;
+			trim(keyBegin, keyEnd);
+			const char *valueBegin = eq + 1;
+			const char *valueEnd = contentEnd;
+			trim(valueBegin, valueEnd);
+
+			// keeps the capacity, unlike clear()
+			value.resize(0);
+			unescapeInto(value, valueBegin, valueEnd);
+			insert(QString::fromUtf8(keyBegin, keyEnd - keyBegin), QString::fromUtf8(value));
+		}
+		pos = lineEnd + 1;
 	}
 
 	return true;
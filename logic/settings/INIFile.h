@@ -25,6 +25,7 @@ class INIFile : public QMap<QString, QVariant>
 public:
 	explicit INIFile();
 
+	/// parse UTF-8 `key=value` lines in one pass over the raw bytes
 	bool loadFile(QByteArray file);
 	bool loadFile(QString fileName);
 	bool saveFile(QString fileName);
@@ -16,23 +16,104 @@
 #include "INISettingsObject.h"
 #include "Setting.h"
 
+#include <QCoreApplication>
+#include <QtConcurrentRun>
+
+// how long there have to be no changes before the file is saved, in milliseconds
+#define SAVE_DELAY 500
+
+static bool saveSnapshot(INIFile ini, QString filePath)
+{
+	return ini.saveFile(filePath);
+}
+
 INISettingsObject::INISettingsObject(const QString &path, QObject *parent)
 	: SettingsObject(parent)
 {
 	m_filePath = path;
 	m_ini.loadFile(path);
+
+	m_saveTimer.setSingleShot(true);
+	m_saveTimer.setInterval(SAVE_DELAY);
+	connect(&m_saveTimer, SIGNAL(timeout()), SLOT(save()));
+	connect(&m_saver, SIGNAL(finished()), SLOT(saved()));
+	if (QCoreApplication::instance())
+	{
+		connect(QCoreApplication::instance(), SIGNAL(aboutToQuit()), SLOT(flush()));
+	}
+}
+
+INISettingsObject::~INISettingsObject()
+{
+	flush();
 }
 
 void INISettingsObject::setFilePath(const QString &filePath)
 {
+	// what was changed so far belongs to the old file
+	flush();
 	m_filePath = filePath;
 }
 
 bool INISettingsObject::reload()
 {
+	flush();
 	return m_ini.loadFile(m_filePath) && SettingsObject::reload();
 }
 
+void INISettingsObject::scheduleSave()
+{
+	m_dirty = true;
+	if (!inTransaction())
+	{
+		m_saveTimer.start();
+	}
+}
+
+void INISettingsObject::transactionCommitted()
+{
+	if (m_dirty)
+	{
+		m_saveTimer.start();
+	}
+}
+
+void INISettingsObject::save()
+{
+	// only one save at a time. Once it's done, saved() starts the next one.
+	if (!m_dirty || m_saver.isRunning())
+		return;
+	m_dirty = false;
+	// the copy is cheap, INIFile is implicitly shared
+	m_saver.setFuture(QtConcurrent::run(saveSnapshot, m_ini, m_filePath));
+}
+
+void INISettingsObject::saved()
+{
+	if (m_dirty && !inTransaction())
+	{
+		m_saveTimer.start();
+	}
+}
+
+void INISettingsObject::flush()
+{
+	m_saveTimer.stop();
+	m_saver.waitForFinished();
+	if (m_dirty)
+	{
+		m_dirty = false;
+		m_ini.saveFile(m_filePath);
+	}
+}
+
+void INISettingsObject::discard()
+{
+	m_saveTimer.stop();
+	m_saver.waitForFinished();
+	m_dirty = false;
+}
+
 void INISettingsObject::changeSetting(const Setting &setting, QVariant value)
 {
 	if (contains(setting.id()))
@@ -51,7 +132,7 @@ void INISettingsObject::changeSetting(const Setting &setting, QVariant value)
 			for(auto iter: setting.configKeys())
 				m_ini.remove(iter);
 		}
-		m_ini.saveFile(m_filePath);
+		scheduleSave();
 	}
 }
 
@@ -62,7 +143,7 @@ void INISettingsObject::resetSetting(const Setting &setting)
 	{
 		for(auto iter: setting.configKeys())
 			m_ini.remove(iter);
-		m_ini.saveFile(m_filePath);
+		scheduleSave();
 	}
 }
 
@@ -16,6 +16,8 @@
 #pragma once
 
 #include <QObject>
+#include <QTimer>
+#include <QFutureWatcher>
 
 #include "logic/settings/INIFile.h"
 
@@ -23,12 +25,17 @@
 
 /*!
  * \brief A settings object that stores its settings in an INIFile.
+ *
+ * Changes aren't written right away. Once there have been no changes for a short while,
+ * the file is saved in a worker thread, with everything changed until then.
+ * Anything still unsaved is saved when the object is destroyed or the application quits.
  */
 class INISettingsObject : public SettingsObject
 {
 	Q_OBJECT
 public:
 	explicit INISettingsObject(const QString &path, QObject *parent = 0);
+	virtual ~INISettingsObject();
 
 	/*!
 	 * \brief Gets the path to the INI file.
@@ -47,15 +54,34 @@ public:
 
 	bool reload() override;
 
+public
+slots:
+	void flush() override;
+	void discard() override;
+
 protected
 slots:
 	virtual void changeSetting(const Setting &setting, QVariant value);
 	virtual void resetSetting(const Setting &setting);
 
+private
+slots:
+	void save();
+	void saved();
+
 protected:
 	virtual QVariant retrieveValue(const Setting &setting);
+	void transactionCommitted() override;
+	void scheduleSave();
 
 	INIFile m_ini;
 
 	QString m_filePath;
+
+private:
+	/// started by every change, the file is saved when it runs out
+	QTimer m_saveTimer;
+	/// there are changes that haven't been handed to the saver yet
+	bool m_dirty = false;
+	QFutureWatcher<bool> m_saver;
 };
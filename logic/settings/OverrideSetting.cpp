@@ -19,6 +19,9 @@ OverrideSetting::OverrideSetting(std::shared_ptr<Setting> other)
 	: Setting(other->configKeys(), QVariant())
 {
 	m_other = other;
+	// the default value comes from the other setting
+	connect(other.get(), SIGNAL(SettingChanged(const Setting &, QVariant)), SLOT(invalidate()));
+	connect(other.get(), SIGNAL(settingReset(Setting)), SLOT(invalidate()));
 }
 
 QVariant OverrideSetting::defValue() const
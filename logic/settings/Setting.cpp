@@ -28,13 +28,16 @@ QVariant Setting::get() const
 	{
 		return defValue();
 	}
-	else
+	if (m_cached)
 	{
-		QVariant test = sbase->retrieveValue(*this);
-		if (!test.isValid())
-			return defValue();
-		return test;
+		return m_cachedValue;
 	}
+	QVariant test = sbase->retrieveValue(*this);
+	if (!test.isValid())
+		test = defValue();
+	m_cachedValue = test;
+	m_cached = true;
+	return test;
 }
 
 QVariant Setting::defValue() const
@@ -44,10 +47,22 @@ QVariant Setting::defValue() const
 
 void Setting::set(QVariant value)
 {
+	invalidate();
 	emit SettingChanged(*this, value);
+	// in case someone read the old value while the signal was going around
+	invalidate();
 }
 
 void Setting::reset()
 {
+	invalidate();
 	emit settingReset(*this);
+	invalidate();
+}
+
+void Setting::invalidate()
+{
+	m_cached = false;
+	m_cachedValue = QVariant();
+	m_generation++;
 }
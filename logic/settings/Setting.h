@@ -78,6 +78,15 @@ public:
 	 */
 	virtual QVariant defValue() const;
 
+	/*!
+	 * \brief Changes every time the value may have changed.
+	 * \sa SettingHandle
+	 */
+	quint32 generation() const
+	{
+		return m_generation;
+	}
+
 signals:
 	/*!
 	 * \brief Signal emitted when this Setting object's value changes.
@@ -109,9 +118,72 @@ slots:
 	 */
 	virtual void reset();
 
+protected
+slots:
+	/*!
+	 * \brief Forgets the cached value, so the next get() looks it up again.
+	 */
+	void invalidate();
+
 protected:
 	friend class SettingsObject;
 	SettingsObject * m_storage;
 	QStringList m_synonyms;
 	QVariant m_defVal;
+
+	/// get() is only looked up in the settings object again after the value changes
+	mutable QVariant m_cachedValue;
+	mutable bool m_cached = false;
+	quint32 m_generation = 1;
+};
+
+/*!
+ * \brief Typed access to a setting, for code that reads it often.
+ *
+ * Get one when the setting is registered and keep it. Reading it only looks up and converts
+ * the value again when the setting has changed since the last read.
+ */
+template <typename T>
+class SettingHandle
+{
+public:
+	SettingHandle()
+	{
+	}
+	explicit SettingHandle(std::shared_ptr<Setting> setting) : m_setting(setting)
+	{
+	}
+
+	const T &get() const
+	{
+		if (m_generation != m_setting->generation())
+		{
+			m_value = m_setting->get().template value<T>();
+			m_generation = m_setting->generation();
+		}
+		return m_value;
+	}
+	void set(const T &value)
+	{
+		m_setting->set(QVariant::fromValue(value));
+	}
+	void reset()
+	{
+		m_setting->reset();
+	}
+
+	std::shared_ptr<Setting> setting() const
+	{
+		return m_setting;
+	}
+	bool isValid() const
+	{
+		return m_setting != nullptr;
+	}
+
+private:
+	std::shared_ptr<Setting> m_setting;
+	mutable T m_value = T();
+	/// generation of the setting m_value was read at, settings start at 1
+	mutable quint32 m_generation = 0;
 };
@@ -105,6 +105,11 @@ bool SettingsObject::contains(const QString &id)
 
 bool SettingsObject::reload()
 {
+	// the cached values are from before the reload
+	for (auto setting : m_settings.values())
+	{
+		setting->invalidate();
+	}
 	for (auto setting : m_settings.values())
 	{
 		setting->set(setting->get());
@@ -112,6 +117,24 @@ bool SettingsObject::reload()
 	return true;
 }
 
+void SettingsObject::beginTransaction()
+{
+	m_transactionDepth++;
+}
+
+void SettingsObject::commitTransaction()
+{
+	if (m_transactionDepth == 0)
+	{
+		QLOG_ERROR() << "Settings transaction committed without being started";
+		return;
+	}
+	if (--m_transactionDepth == 0)
+	{
+		transactionCommitted();
+	}
+}
+
 void SettingsObject::connectSignals(const Setting &setting)
 {
 	connect(&setting, SIGNAL(SettingChanged(const Setting &, QVariant)),
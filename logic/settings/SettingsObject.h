@@ -117,6 +117,34 @@ public:
 	 */
 	virtual bool reload();
 
+	/*!
+	 * \brief Starts a transaction. Changes made during it are saved together, after the
+	 * outermost transaction is committed. Transactions can be nested.
+	 */
+	void beginTransaction();
+
+	/*!
+	 * \brief Ends a transaction started with beginTransaction().
+	 */
+	void commitTransaction();
+
+public
+slots:
+	/*!
+	 * \brief Saves any changes that are still waiting to be saved, and waits until they are.
+	 */
+	virtual void flush()
+	{
+	}
+
+	/*!
+	 * \brief Drops any changes that are still waiting to be saved, and waits for a save
+	 * that is already running. Nothing is written afterwards unless settings change again.
+	 */
+	virtual void discard()
+	{
+	}
+
 signals:
 	/*!
 	 * \brief Signal emitted when one of this SettingsObject object's settings changes.
@@ -170,8 +198,21 @@ protected:
 	 */
 	virtual QVariant retrieveValue(const Setting &setting) = 0;
 
+	/*!
+	 * \brief Called when the outermost transaction is committed.
+	 */
+	virtual void transactionCommitted()
+	{
+	}
+
+	bool inTransaction() const
+	{
+		return m_transactionDepth > 0;
+	}
+
 	friend class Setting;
 
 private:
 	QMap<QString, std::shared_ptr<Setting>> m_settings;
+	int m_transactionDepth = 0;
 };
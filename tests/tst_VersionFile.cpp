@@ -0,0 +1,208 @@
+#include <QTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include "TestUtil.h"
+
+#include "logic/minecraft/InstanceVersion.h"
+#include "logic/minecraft/VersionFile.h"
+
+class VersionFileTest : public QObject
+{
+	Q_OBJECT
+
+	static QJsonObject lib(const QString &name, const QJsonValue &insert = QJsonValue())
+	{
+		QJsonObject obj;
+		obj.insert("name", name);
+		if (!insert.isNull())
+			obj.insert("insert", insert);
+		return obj;
+	}
+	static QJsonObject replaceRule(const QString &name)
+	{
+		QJsonObject obj;
+		obj.insert("replace", name);
+		return obj;
+	}
+
+	static VersionFilePtr minecraftFile(const QJsonArray &libraries)
+	{
+		QJsonObject root;
+		root.insert("fileId", QString("net.minecraft"));
+		root.insert("libraries", libraries);
+		return VersionFile::fromJson(QJsonDocument(root), "minecraft.json", false);
+	}
+	static VersionFilePtr patchFile(const QJsonArray &added,
+									const QStringList &removed = QStringList())
+	{
+		QJsonObject root;
+		root.insert("fileId", QString("org.multimc.test"));
+		root.insert("+libraries", added);
+		QJsonArray removedArray;
+		for (auto name : removed)
+		{
+			removedArray.append(lib(name));
+		}
+		if (!removed.isEmpty())
+			root.insert("-libraries", removedArray);
+		return VersionFile::fromJson(QJsonDocument(root), "patch.json", false);
+	}
+
+	static QStringList names(const InstanceVersion &version)
+	{
+		QStringList out;
+		for (auto library : version.libraries)
+		{
+			out.append(library->rawName());
+		}
+		return out;
+	}
+
+	// the libraries of a big modded instance: a base version and a stack of patches
+	QList<VersionFilePtr> syntheticStack()
+	{
+		QJsonArray base;
+		for (int i = 0; i < 500; i++)
+		{
+			base.append(lib(QString("org.example.group%1:artifact%2:1.0").arg(i % 20).arg(i)));
+		}
+		QList<VersionFilePtr> stack;
+		stack.append(minecraftFile(base));
+		for (int patch = 0; patch < 5; patch++)
+		{
+			QJsonArray added;
+			for (int i = 0; i < 100; i++)
+			{
+				const int target = patch * 100 + i;
+				switch (i % 4)
+				{
+				case 0:
+					added.append(lib(QString("org.example.group%1:artifact%2:2.0")
+										 .arg(target % 20)
+										 .arg(target),
+									 QString("append")));
+					break;
+				case 1:
+					added.append(lib(QString("org.added.patch%1:new%2:1.0").arg(patch).arg(i),
+									 QString("prepend")));
+					break;
+				case 2:
+					added.append(lib(QString("org.added.patch%1:replacement%2:1.0")
+										 .arg(patch)
+										 .arg(i),
+									 replaceRule(QString("org.example.group%1:artifact%2:1.0")
+													 .arg(target % 20)
+													 .arg(target))));
+					break;
+				case 3:
+					added.append(lib(QString("org.example.group%1:artifact%2:1.0")
+										 .arg(target % 20)
+										 .arg(target),
+									 QString("apply")));
+					break;
+				}
+			}
+			stack.append(patchFile(added));
+		}
+		return stack;
+	}
+
+private
+slots:
+	void initTestCase()
+	{
+	}
+	void cleanupTestCase()
+	{
+	}
+
+	void test_appendPrepend()
+	{
+		InstanceVersion version(nullptr);
+		minecraftFile(QJsonArray() << lib("a:a:1") << lib("b:b:1"))->applyTo(&version);
+		patchFile(QJsonArray() << lib("p:first:1", QString("prepend"))
+							   << lib("p:second:1", QString("prepend"))
+							   << lib("z:z:1", QString("append")))->applyTo(&version);
+		QCOMPARE(names(version), QStringList() << "p:second:1"
+											   << "p:first:1"
+											   << "a:a:1"
+											   << "b:b:1"
+											   << "z:z:1");
+	}
+
+	void test_upgrade()
+	{
+		InstanceVersion version(nullptr);
+		minecraftFile(QJsonArray() << lib("a:a:1") << lib("b:b:1"))->applyTo(&version);
+		patchFile(QJsonArray() << lib("a:a:2") << lib("b:b:0", QString("prepend")))
+			->applyTo(&version);
+		// newer versions replace in place, older ones are ignored
+		QCOMPARE(names(version), QStringList() << "a:a:2"
+											   << "b:b:1");
+	}
+
+	void test_replaceRemove()
+	{
+		InstanceVersion version(nullptr);
+		minecraftFile(QJsonArray() << lib("a:a:1") << lib("b:b:1") << lib("c:c:1"))
+			->applyTo(&version);
+		patchFile(QJsonArray() << lib("x:x:1", replaceRule("b:b:1"))
+							   << lib("y:y:1", QString("prepend")),
+				  QStringList() << "a:a:1"
+								<< "y:y:1")->applyTo(&version);
+		QCOMPARE(names(version), QStringList() << "x:x:1"
+											   << "c:c:1");
+
+		// the replacement can be found under its own name afterwards
+		patchFile(QJsonArray(), QStringList() << "x:x:1")->applyTo(&version);
+		QCOMPARE(names(version), QStringList() << "c:c:1");
+	}
+
+	void test_ambiguous()
+	{
+		InstanceVersion version(nullptr);
+		minecraftFile(QJsonArray() << lib("n:n:1:natives-linux") << lib("n:n:1:natives-osx"))
+			->applyTo(&version);
+		// with more than one library of the same name, none of them are touched
+		patchFile(QJsonArray() << lib("n:n:2") << lib("m:m:1", replaceRule("n:n:1")),
+				  QStringList() << "n:n:1")->applyTo(&version);
+		QCOMPARE(names(version), QStringList() << "n:n:1:natives-linux"
+											   << "n:n:1:natives-osx"
+											   << "n:n:2");
+	}
+
+	void test_syntheticStack()
+	{
+		InstanceVersion version(nullptr);
+		for (auto file : syntheticStack())
+		{
+			file->applyTo(&version);
+		}
+		// 500 base libraries, 125 prepended, 125 replaced in place
+		QCOMPARE(version.libraries.size(), 625);
+		QCOMPARE(QString(version.libraries.first()->rawName()),
+				 QString("org.added.patch4:new97:1.0"));
+		QCOMPARE(QString(version.libraries[125]->rawName()),
+				 QString("org.example.group0:artifact0:2.0"));
+		QCOMPARE(QString(version.libraries[127]->rawName()),
+				 QString("org.added.patch0:replacement2:1.0"));
+	}
+
+	void bench_applyTo()
+	{
+		auto stack = syntheticStack();
+		QBENCHMARK
+		{
+			InstanceVersion version(nullptr);
+			for (auto file : stack)
+			{
+				file->applyTo(&version);
+			}
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN_MULTIMC(VersionFileTest)
+
+#include "tst_VersionFile.moc"
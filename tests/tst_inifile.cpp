@@ -1,7 +1,9 @@
 #include <QTest>
+#include <QTemporaryDir>
 #include "TestUtil.h"
 
 #include "logic/settings/INIFile.h"
+#include "logic/settings/INISettingsObject.h"
 
 class IniFileTest : public QObject
 {
@@ -26,6 +28,7 @@ slots:
 		QTest::newRow("Plain text") << "Lorem ipsum dolor sit amet.";
 		QTest::newRow("Escape sequences") << "Lorem\n\t\n\\n\\tAAZ\nipsum dolor\n\nsit amet.";
 		QTest::newRow("Escape sequences 2") << "\"\n\n\"";
+		QTest::newRow("Hash") << "Mod #1 \\# not a comment";
 	}
 	void test_PathCombine1()
 	{
@@ -36,6 +39,193 @@ slots:
 		
 		QCOMPARE(back, through);
 	}
+
+	void test_loadFile()
+	{
+		INIFile ini;
+		QVERIFY(ini.loadFile(QByteArray("\xEF\xBB\xBF"
+										 "# comment\n"
+										 "  name = Foo Bar  \r\n"
+										 "notes=line\\none\\ttab\\\\ # trailing comment\n"
+										 "hash=Mod \\#1 # comment\n"
+										 "\n"
+										 "no equals sign\n"
+										 "JvmArgs=-Da=b -Dc=d\n"
+										 "unicode=\xC5\xBElu\xC5\xA5ou\xC4\x8Dk\xC3\xBD\n"
+										 "last=no newline")));
+		QCOMPARE(ini.size(), 6);
+		QCOMPARE(ini.get("hash", QVariant()).toString(), QString("Mod #1"));
+		QCOMPARE(ini.get("name", QVariant()).toString(), QString("Foo Bar"));
+		QCOMPARE(ini.get("notes", QVariant()).toString(), QString("line\none\ttab\\"));
+		QCOMPARE(ini.get("JvmArgs", QVariant()).toString(), QString("-Da=b -Dc=d"));
+		QCOMPARE(ini.get("unicode", QVariant()).toString(),
+				 QString::fromUtf8("\xC5\xBElu\xC5\xA5ou\xC4\x8Dk\xC3\xBD"));
+		QCOMPARE(ini.get("last", QVariant()).toString(), QString("no newline"));
+	}
+
+	void test_saveFile()
+	{
+		QTemporaryDir dir;
+		const QString path = dir.path() + "/instance.cfg";
+		INIFile ini;
+		ini.set("notes", "first line\nsecond line\twith a tab and a \\, Mod #1 \\#");
+		ini.set("lastLaunchTime", 1234);
+		ini.set("name", QString::fromUtf8("\xC5\xBElu\xC5\xA5ou\xC4\x8Dk\xC3\xBD"));
+		QVERIFY(ini.saveFile(path));
+
+		INIFile loaded;
+		QVERIFY(loaded.loadFile(path));
+		QCOMPARE(loaded.size(), 3);
+		QCOMPARE(loaded.get("notes", QVariant()).toString(), ini.get("notes", QVariant()).toString());
+		QCOMPARE(loaded.get("lastLaunchTime", QVariant()).toInt(), 1234);
+		QCOMPARE(loaded.get("name", QVariant()).toString(), ini.get("name", QVariant()).toString());
+	}
+
+	void test_settingsSavedLater()
+	{
+		QTemporaryDir dir;
+		const QString path = dir.path() + "/instance.cfg";
+		INISettingsObject settings(path);
+		settings.registerSetting("name", "");
+		settings.registerSetting("lastLaunchTime", 0);
+
+		settings.set("name", "foo");
+		settings.set("lastLaunchTime", 1234);
+		QVERIFY(!QFile::exists(path));
+		QTRY_VERIFY(QFile::exists(path));
+
+		INIFile ini;
+		QVERIFY(ini.loadFile(path));
+		QCOMPARE(ini.get("name", QVariant()).toString(), QString("foo"));
+		QCOMPARE(ini.get("lastLaunchTime", QVariant()).toInt(), 1234);
+	}
+
+	void test_settingsTransaction()
+	{
+		QTemporaryDir dir;
+		const QString path = dir.path() + "/instance.cfg";
+		INISettingsObject settings(path);
+		settings.registerSetting("name", "");
+
+		settings.beginTransaction();
+		settings.set("name", "foo");
+		QTest::qWait(1000);
+		QVERIFY(!QFile::exists(path));
+		settings.commitTransaction();
+		QTRY_VERIFY(QFile::exists(path));
+	}
+
+	void test_settingsFlush()
+	{
+		QTemporaryDir dir;
+		const QString path = dir.path() + "/instance.cfg";
+		{
+			INISettingsObject settings(path);
+			settings.registerSetting("name", "");
+			settings.set("name", "foo");
+			settings.flush();
+			QVERIFY(QFile::exists(path));
+			settings.set("name", "bar");
+		}
+		// destroying it saves the rest
+		INIFile ini;
+		QVERIFY(ini.loadFile(path));
+		QCOMPARE(ini.get("name", QVariant()).toString(), QString("bar"));
+	}
+
+	void test_settingsDiscard()
+	{
+		QTemporaryDir dir;
+		const QString path = dir.path() + "/instance.cfg";
+		{
+			INISettingsObject settings(path);
+			settings.registerSetting("name", "");
+			settings.set("name", "foo");
+			settings.discard();
+			QTest::qWait(1000);
+			QVERIFY(!QFile::exists(path));
+		}
+		// nor does destroying it save anything
+		QVERIFY(!QFile::exists(path));
+	}
+
+	void test_settingHandle()
+	{
+		QTemporaryDir dir;
+		INISettingsObject global(dir.path() + "/multimc.cfg");
+		INISettingsObject instance(dir.path() + "/instance.cfg");
+		global.registerSetting("MaxMemAlloc", 1024);
+		SettingHandle<int> maxMem(instance.registerOverride(global.getSetting("MaxMemAlloc")));
+
+		QCOMPARE(maxMem.get(), 1024);
+		// the override follows the global setting until it has its own value
+		global.set("MaxMemAlloc", 2048);
+		QCOMPARE(maxMem.get(), 2048);
+		maxMem.set(512);
+		QCOMPARE(maxMem.get(), 512);
+		QCOMPARE(instance.get("MaxMemAlloc").toInt(), 512);
+		global.set("MaxMemAlloc", 4096);
+		QCOMPARE(maxMem.get(), 512);
+		maxMem.reset();
+		QCOMPARE(maxMem.get(), 4096);
+	}
+
+	// a directory with a few hundred instance configs, like the ones loaded on startup
+	void bench_loadInstanceConfigs()
+	{
+		QTemporaryDir dir;
+		QStringList paths;
+		for (int i = 0; i < 500; i++)
+		{
+			INIFile ini;
+			ini.set("InstanceType", "OneSix");
+			ini.set("IntendedVersion", "1.7.10");
+			ini.set("name", QString("Instance %1").arg(i));
+			ini.set("iconKey", "infinity");
+			ini.set("notes", "Modded survival world.\nBackups in the saves folder.\n\tDon't update Forge!");
+			ini.set("lastLaunchTime", 1420070400000LL + i);
+			ini.set("OverrideMemory", true);
+			ini.set("MinMemAlloc", 1024);
+			ini.set("MaxMemAlloc", 4096);
+			ini.set("PermGen", 256);
+			ini.set("OverrideJava", true);
+			ini.set("JavaPath", "/usr/lib/jvm/java-8-openjdk/jre/bin/java");
+			ini.set("JvmArgs", "-XX:+UseConcMarkSweepGC -XX:+CMSIncrementalMode -XX:-UseAdaptiveSizePolicy");
+			ini.set("OverrideWindow", false);
+			ini.set("LaunchMaximized", false);
+			ini.set("MinecraftWinWidth", 854);
+			ini.set("MinecraftWinHeight", 480);
+			ini.set("ShowConsole", true);
+			ini.set("AutoCloseConsole", true);
+			ini.set("LogPrePostOutput", true);
+			const QString path = dir.path() + QString("/%1.cfg").arg(i);
+			QVERIFY(ini.saveFile(path));
+			paths.append(path);
+		}
+		QBENCHMARK
+		{
+			for (auto &path : paths)
+			{
+				INIFile ini;
+				ini.loadFile(path);
+			}
+		}
+	}
+
+	void bench_saveInstanceConfig()
+	{
+		QTemporaryDir dir;
+		const QString path = dir.path() + "/instance.cfg";
+		INIFile ini;
+		for (int i = 0; i < 50; i++)
+		{
+			ini.set(QString("key%1").arg(i), QString("value %1\nwith\tescapes \\ in it").arg(i));
+		}
+		QBENCHMARK
+		{
+			ini.saveFile(path);
+		}
+	}
 };
 
 QTEST_GUILESS_MAIN_MULTIMC(IniFileTest)
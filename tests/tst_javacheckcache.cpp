@@ -0,0 +1,103 @@
+#include <QTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include "TestUtil.h"
+
+#include "logic/java/JavaCheckCache.h"
+
+class JavaCheckCacheTest : public QObject
+{
+	Q_OBJECT
+
+	void writeFile(const QString &path, const QByteArray &content)
+	{
+		QFile file(path);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		file.write(content);
+	}
+
+	JavaCheckResult validResult()
+	{
+		JavaCheckResult result;
+		result.valid = true;
+		result.is_64bit = true;
+		result.mojangPlatform = "64";
+		result.realPlatform = "amd64";
+		result.javaVersion = "1.8.0_40";
+		return result;
+	}
+
+private
+slots:
+	void test_keyFor()
+	{
+		QTemporaryDir dir;
+		const QString java = dir.path() + "/java";
+		QVERIFY(!JavaCheckCache::keyFor(java).isValid());
+		writeFile(java, "#!/bin/sh\n");
+		auto key = JavaCheckCache::keyFor(java);
+		QVERIFY(key.isValid());
+		QCOMPARE(key.size, qint64(10));
+#ifndef Q_OS_WIN32
+		// links lead to the same binary
+		const QString link = dir.path() + "/link";
+		QVERIFY(QFile::link(java, link));
+		QCOMPARE(JavaCheckCache::keyFor(link).realPath, key.realPath);
+#endif
+	}
+
+	void test_storeAndLoad()
+	{
+		QTemporaryDir dir;
+		const QString java = dir.path() + "/java";
+		const QString index = dir.path() + "/cache/javacheck.json";
+		writeFile(java, "#!/bin/sh\n");
+		auto key = JavaCheckCache::keyFor(java);
+		{
+			JavaCheckCache cache(index);
+			JavaCheckResult result;
+			QVERIFY(!cache.get(key, result));
+			cache.put(key, validResult());
+			QVERIFY(cache.get(key, result));
+			QVERIFY(cache.save());
+		}
+		JavaCheckCache cache(index);
+		JavaCheckResult result;
+		QVERIFY(cache.get(key, result));
+		QVERIFY(result.valid);
+		QVERIFY(result.is_64bit);
+		QCOMPARE(result.mojangPlatform, QString("64"));
+		QCOMPARE(result.realPlatform, QString("amd64"));
+		QCOMPARE(result.javaVersion, QString("1.8.0_40"));
+	}
+
+	void test_changedBinary()
+	{
+		QTemporaryDir dir;
+		const QString java = dir.path() + "/java";
+		writeFile(java, "#!/bin/sh\n");
+		JavaCheckCache cache(dir.path() + "/javacheck.json");
+		cache.put(JavaCheckCache::keyFor(java), validResult());
+
+		writeFile(java, "#!/bin/sh\nexit 1\n");
+		JavaCheckResult result;
+		QVERIFY(!cache.get(JavaCheckCache::keyFor(java), result));
+	}
+
+	void test_failedChecksNotKept()
+	{
+		QTemporaryDir dir;
+		const QString java = dir.path() + "/java";
+		writeFile(java, "#!/bin/sh\n");
+		auto key = JavaCheckCache::keyFor(java);
+		JavaCheckCache cache(dir.path() + "/javacheck.json");
+		cache.put(key, validResult());
+		cache.put(key, JavaCheckResult());
+		JavaCheckResult result;
+		QVERIFY(!cache.get(key, result));
+	}
+};
+
+QTEST_GUILESS_MAIN_MULTIMC(JavaCheckCacheTest)
+
+#include "tst_javacheckcache.moc"
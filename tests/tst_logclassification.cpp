@@ -0,0 +1,259 @@
+#include <QTest>
+#include <QRegularExpression>
+#include <QSet>
+#include "TestUtil.h"
+
+#include "logic/MessageLevel.h"
+#include "logic/LogCensor.h"
+
+// the way things were done before the classifiers got compiled, kept as a baseline
+namespace Baseline
+{
+MessageLevel::Enum guessLevel(const QString &line, MessageLevel::Enum level)
+{
+	QRegularExpression re("\\[(?<timestamp>[0-9:]+)\\] \\[[^/]+/(?<level>[^\\]]+)\\]");
+	auto match = re.match(line);
+	if (match.hasMatch())
+	{
+		QString levelStr = match.captured("level");
+		if (levelStr == "INFO")
+			level = MessageLevel::Message;
+		if (levelStr == "WARN")
+			level = MessageLevel::Warning;
+		if (levelStr == "ERROR")
+			level = MessageLevel::Error;
+		if (levelStr == "FATAL")
+			level = MessageLevel::Fatal;
+		if (levelStr == "TRACE" || levelStr == "DEBUG")
+			level = MessageLevel::Debug;
+	}
+	else
+	{
+		if (line.contains("[INFO]") || line.contains("[CONFIG]") || line.contains("[FINE]") ||
+			line.contains("[FINER]") || line.contains("[FINEST]"))
+			level = MessageLevel::Message;
+		if (line.contains("[SEVERE]") || line.contains("[STDERR]"))
+			level = MessageLevel::Error;
+		if (line.contains("[WARNING]"))
+			level = MessageLevel::Warning;
+		if (line.contains("[DEBUG]"))
+			level = MessageLevel::Debug;
+	}
+	if (line.contains("overwriting existing"))
+		return MessageLevel::Fatal;
+	if (line.contains("Exception in thread") || line.contains(QRegularExpression("\\s+at ")))
+		return MessageLevel::Error;
+	return level;
+}
+
+QString censor(QString in, const QMap<QString, QString> &replacements)
+{
+	for (auto it = replacements.begin(); it != replacements.end(); ++it)
+	{
+		in.replace(it.key(), it.value());
+	}
+	return in;
+}
+}
+
+class LogClassificationTest : public QObject
+{
+	Q_OBJECT
+
+	/// hand-written (synthetic) game output, covering the line formats seen in real logs:
+	/// log4j, legacy [TAG] levels, FML, stack traces and plain text
+	QStringList m_corpus;
+	/// a long session's worth of output generated from m_corpus, used by the benchmarks
+	QStringList m_log;
+	QMap<QString, QString> m_replacements;
+
+	/// expands the corpus into \a count lines of plausible game output: mostly log4j lines
+	/// with a running clock, thread names and numbers that vary, and the odd stack trace.
+	/// deterministic, so runs are comparable.
+	static QStringList generateLog(const QStringList &corpus, int count)
+	{
+		QStringList log4j, other, trace;
+		QRegularExpression stamp("^\\[[0-9:]+\\] \\[([^/]+)/");
+		for (auto &line : corpus)
+		{
+			if (line.isEmpty())
+				continue;
+			if (stamp.match(line).hasMatch())
+				log4j.append(line.mid(line.indexOf(']') + 2));
+			else if (line.startsWith('\t') || line.startsWith("    ") || line.startsWith("Caused by"))
+				trace.append(line);
+			else
+				other.append(line);
+		}
+		static const char *threads[] = {"Client thread", "Server thread", "main",
+										"Netty Client IO #0", "File IO Thread"};
+
+		QStringList result;
+		result.reserve(count);
+		quint32 seed = 1;
+		auto next = [&seed](quint32 bound)
+		{
+			seed = seed * 1103515245u + 12345u;
+			return (seed >> 16) % bound;
+		};
+		int seconds = 0;
+		while (result.size() < count)
+		{
+			seconds += next(3);
+			const QString time = QString("[%1:%2:%3] ")
+									 .arg(12 + seconds / 3600 % 12, 2, 10, QChar('0'))
+									 .arg(seconds / 60 % 60, 2, 10, QChar('0'))
+									 .arg(seconds % 60, 2, 10, QChar('0'));
+			const quint32 kind = next(100);
+			if (kind < 85)
+			{
+				QString line = log4j[next(log4j.size())];
+				// swap the thread name and tack on a varying number, like a tick or entity id
+				const int slash = line.indexOf('/');
+				if (slash > 1)
+					line.replace(1, slash - 1, threads[next(5)]);
+				result.append(time + line + " " + QString::number(next(100000)));
+			}
+			else if (kind < 95)
+			{
+				result.append(other[next(other.size())]);
+			}
+			else
+			{
+				const int depth = 5 + next(30);
+				result.append("java.lang.NullPointerException");
+				for (int i = 0; i < depth && result.size() < count; i++)
+				{
+					result.append(trace[next(trace.size())]);
+				}
+			}
+		}
+		return result;
+	}
+
+private
+slots:
+	void initTestCase()
+	{
+		m_corpus = MULTIMC_GET_TEST_FILE_UTF8("data/tst_logclassification-corpus.txt")
+					   .split('\n');
+		QVERIFY(m_corpus.size() > 1);
+		// about what a couple of hours of a modded client leaves behind
+		m_log = generateLog(m_corpus, 100000);
+
+		m_replacements.insert("3f2c9a1b7e6d4c8a9b0e1f2a3b4c5d6e", "<ACCESS TOKEN>");
+		m_replacements.insert("11112222333344445555666677778888", "<CLIENT TOKEN>");
+		m_replacements.insert("0d4c7e5b2a9f4e1c8b3a6d5e4f3c2b1a", "<PROFILE ID>");
+		m_replacements.insert("Player", "<PROFILE NAME>");
+		m_replacements.insert("token:3f2c9a1b7e6d4c8a9b0e1f2a3b4c5d6e:"
+							  "0d4c7e5b2a9f4e1c8b3a6d5e4f3c2b1a",
+							  "<SESSION ID>");
+	}
+	void cleanupTestCase()
+	{
+	}
+
+	void test_guessLevel_matchesBaseline()
+	{
+		for (auto &line : m_corpus)
+		{
+			QCOMPARE(MessageLevel::guessLevel(line, MessageLevel::Message),
+					 Baseline::guessLevel(line, MessageLevel::Message));
+			QCOMPARE(MessageLevel::guessLevel(line, MessageLevel::Error),
+					 Baseline::guessLevel(line, MessageLevel::Error));
+		}
+	}
+	void test_generatedLog()
+	{
+		QCOMPARE(m_log.size(), 100000);
+		// the generated lines must still hit every classification, or the benchmarks are
+		// measuring only the cheap paths
+		QSet<int> levels;
+		for (int i = 0; i < m_log.size(); i += 7)
+		{
+			const auto level = MessageLevel::guessLevel(m_log[i], MessageLevel::Message);
+			QCOMPARE(level, Baseline::guessLevel(m_log[i], MessageLevel::Message));
+			levels.insert(level);
+		}
+		QVERIFY(levels.contains(MessageLevel::Message));
+		QVERIFY(levels.contains(MessageLevel::Warning));
+		QVERIFY(levels.contains(MessageLevel::Error));
+		QVERIFY(levels.contains(MessageLevel::Fatal));
+		QVERIFY(levels.contains(MessageLevel::Debug));
+	}
+
+	void test_censor_data()
+	{
+		QTest::addColumn<QString>("in");
+		QTest::addColumn<QString>("out");
+
+		QTest::newRow("nothing") << "nothing to see here" << "nothing to see here";
+		QTest::newRow("empty") << "" << "";
+		QTest::newRow("single") << "Setting user: Player" << "Setting user: <PROFILE NAME>";
+		QTest::newRow("several") << "Player, 3f2c9a1b7e6d4c8a9b0e1f2a3b4c5d6e, Player"
+								 << "<PROFILE NAME>, <ACCESS TOKEN>, <PROFILE NAME>";
+		QTest::newRow("longest wins")
+			<< "(Session ID is token:3f2c9a1b7e6d4c8a9b0e1f2a3b4c5d6e:"
+			   "0d4c7e5b2a9f4e1c8b3a6d5e4f3c2b1a)"
+			<< "(Session ID is <SESSION ID>)";
+		QTest::newRow("partial") << "Playe token:3f2c" << "Playe token:3f2c";
+		QTest::newRow("adjacent") << "PlayerPlayer" << "<PROFILE NAME><PROFILE NAME>";
+	}
+	void test_censor()
+	{
+		QFETCH(QString, in);
+		QFETCH(QString, out);
+
+		LogCensor censor;
+		censor.setReplacements(m_replacements);
+		QCOMPARE(censor.censor(in), out);
+	}
+
+	void bench_guessLevel_baseline()
+	{
+		QBENCHMARK
+		{
+			for (auto &line : m_log)
+			{
+				Baseline::guessLevel(line, MessageLevel::Message);
+			}
+		}
+	}
+	void bench_guessLevel()
+	{
+		QBENCHMARK
+		{
+			for (auto &line : m_log)
+			{
+				MessageLevel::guessLevel(line, MessageLevel::Message);
+			}
+		}
+	}
+
+	void bench_censor_baseline()
+	{
+		QBENCHMARK
+		{
+			for (auto &line : m_log)
+			{
+				Baseline::censor(line, m_replacements);
+			}
+		}
+	}
+	void bench_censor()
+	{
+		LogCensor censor;
+		censor.setReplacements(m_replacements);
+		QBENCHMARK
+		{
+			for (auto &line : m_log)
+			{
+				censor.censor(line);
+			}
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN_MULTIMC(LogClassificationTest)
+
+#include "tst_logclassification.moc"
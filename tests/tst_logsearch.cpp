@@ -0,0 +1,140 @@
+#include <QTest>
+#include "TestUtil.h"
+
+#include "logic/LogModel.h"
+
+class LogSearchTest : public QObject
+{
+	Q_OBJECT
+
+	QStringList m_corpus;
+
+	// fills a model with the corpus, many times over, so old lines get dropped
+	void fill(LogModel &model, int lines)
+	{
+		int level = 0;
+		QStringList batch;
+		for (int i = 0; i < lines; i++)
+		{
+			batch.append(QString("%1 %2").arg(i).arg(m_corpus[i % m_corpus.size()]));
+			if (batch.size() == 100)
+			{
+				model.append((MessageLevel::Enum)(level++ % MessageLevel::PrePost), batch);
+				batch.clear();
+			}
+		}
+		model.append(MessageLevel::Message, batch);
+	}
+
+	int bruteFind(const LogModel &model, const QString &text, int from, bool backwards,
+				  quint32 levelMask)
+	{
+		int step = backwards ? -1 : 1;
+		int start = (from == -1) ? (backwards ? model.rowCount() : -1) : from;
+		for (int row = start + step; row >= 0 && row < model.rowCount(); row += step)
+		{
+			if ((levelMask & (1u << model.level(row))) &&
+				model.line(row).contains(text, Qt::CaseInsensitive))
+				return row;
+		}
+		return -1;
+	}
+
+private
+slots:
+	void initTestCase()
+	{
+		m_corpus = MULTIMC_GET_TEST_FILE_UTF8("data/tst_logclassification-corpus.txt")
+					   .split('\n');
+		QVERIFY(m_corpus.size() > 1);
+	}
+	void cleanupTestCase()
+	{
+	}
+
+	void test_find_data()
+	{
+		QTest::addColumn<QString>("text");
+		QTest::addColumn<quint32>("levelMask");
+
+		QTest::newRow("short") << "at" << LogModel::AllLevels;
+		QTest::newRow("word") << "minecraft" << LogModel::AllLevels;
+		QTest::newRow("case") << "MineCraft" << LogModel::AllLevels;
+		QTest::newRow("number") << "4711 " << LogModel::AllLevels;
+		QTest::newRow("missing") << "this is not in the log" << LogModel::AllLevels;
+		QTest::newRow("errors") << "minecraft" << quint32(1u << MessageLevel::Error);
+		QTest::newRow("no levels") << "minecraft" << quint32(0);
+	}
+	void test_find()
+	{
+		QFETCH(QString, text);
+		QFETCH(quint32, levelMask);
+
+		LogModel model;
+		model.setMaxLines(5000);
+		fill(model, 12345);
+
+		int expectedCount = 0;
+		for (int row = 0; row < model.rowCount(); row++)
+		{
+			if ((levelMask & (1u << model.level(row))) &&
+				model.line(row).contains(text, Qt::CaseInsensitive))
+				expectedCount++;
+		}
+		QCOMPARE(model.countMatches(text, levelMask), expectedCount);
+
+		for (int from : {-1, 0, 63, 64, 2500, 4998, 4999})
+		{
+			QCOMPARE(model.find(text, from, false, levelMask),
+					 bruteFind(model, text, from, false, levelMask));
+			QCOMPARE(model.find(text, from, true, levelMask),
+					 bruteFind(model, text, from, true, levelMask));
+		}
+	}
+
+	void test_clear()
+	{
+		LogModel model;
+		fill(model, 1000);
+		QVERIFY(model.countMatches("minecraft") > 0);
+		model.clear();
+		QCOMPARE(model.countMatches("minecraft"), 0);
+		fill(model, 10);
+		QCOMPARE(model.find("0 ", -1, false), 0);
+	}
+
+	void bench_find_linear()
+	{
+		LogModel model;
+		model.setMaxLines(300000);
+		fill(model, 300000);
+		QBENCHMARK
+		{
+			bruteFind(model, "OutOfMemoryError", -1, false, LogModel::AllLevels);
+		}
+	}
+	void bench_find()
+	{
+		LogModel model;
+		model.setMaxLines(300000);
+		fill(model, 300000);
+		QBENCHMARK
+		{
+			model.find("OutOfMemoryError", -1, false);
+		}
+	}
+	void bench_countMatches()
+	{
+		LogModel model;
+		model.setMaxLines(300000);
+		fill(model, 300000);
+		QBENCHMARK
+		{
+			model.countMatches("OutOfMemoryError");
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN_MULTIMC(LogSearchTest)
+
+#include "tst_logsearch.moc"
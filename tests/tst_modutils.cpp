@@ -15,9 +15,72 @@
 
 #include <QTest>
 
+#include <algorithm>
+
 #include "modutils.h"
 #include "TestUtil.h"
 
+// Util::Version as it was before the packed key, kept as a baseline for the benchmarks
+namespace Baseline
+{
+struct Version
+{
+	Version(const QString &str)
+	{
+		for (const auto part : str.split('.'))
+		{
+			bool ok = false;
+			int num = part.toInt(&ok);
+			if (ok)
+			{
+				m_sections.append(Section(part, num));
+			}
+			else
+			{
+				m_sections.append(Section(part));
+			}
+		}
+	}
+
+	bool operator<(const Version &other) const
+	{
+		const int size = qMax(m_sections.size(), other.m_sections.size());
+		for (int i = 0; i < size; ++i)
+		{
+			const Section sec1 = (i >= m_sections.size()) ? Section("0", 0) : m_sections.at(i);
+			const Section sec2 =
+				(i >= other.m_sections.size()) ? Section("0", 0) : other.m_sections.at(i);
+			if (sec1 != sec2)
+			{
+				return sec1 < sec2;
+			}
+		}
+
+		return false;
+	}
+
+private:
+	struct Section
+	{
+		explicit Section(const QString &str, const int num) : numValid(true), number(num), string(str) {}
+		explicit Section(const QString &str) : numValid(false), string(str) {}
+		bool numValid;
+		int number;
+		QString string;
+
+		inline bool operator!=(const Section &other) const
+		{
+			return (numValid && other.numValid) ? (number != other.number) : (string != other.string);
+		}
+		inline bool operator<(const Section &other) const
+		{
+			return (numValid && other.numValid) ? (number < other.number) : (string < other.string);
+		}
+	};
+	QList<Section> m_sections;
+};
+}
+
 class ModUtilsTest : public QObject
 {
 	Q_OBJECT
@@ -48,6 +111,43 @@ class ModUtilsTest : public QObject
 		QTest::newRow("greaterThan, implicit 2") << "1.3.0" << "1.2" << false << false;
 		QTest::newRow("greaterThan, implicit 3") << "2.2.0" << "1.2" << false << false;
 		QTest::newRow("greaterThan, two-digit") << "1.42" << "1.41" << false << false;
+
+		QTest::newRow("lessThan, string") << "1.2.a" << "1.2.b" << true << false;
+		QTest::newRow("lessThan, implicit string") << "1.2" << "1.2.a" << true << false;
+		QTest::newRow("greaterThan, string") << "1.2.b" << "1.2.a" << false << false;
+		QTest::newRow("equal, string") << "1.2.a" << "1.2.a" << false << true;
+		QTest::newRow("lessThan, big number") << "1.2" << "1.70000" << true << false;
+		QTest::newRow("greaterThan, big number") << "1.70001" << "1.70000" << false << false;
+		QTest::newRow("equal, five sections") << "1.2.3.4.0" << "1.2.3.4" << false << true;
+		QTest::newRow("lessThan, five sections") << "1.2.3.4" << "1.2.3.4.5" << true << false;
+		QTest::newRow("greaterThan, five sections") << "1.2.3.5" << "1.2.3.4.5" << false << false;
+	}
+
+	/// version strings shaped like the ones in the forge version list
+	QStringList forgeVersions(const int count)
+	{
+		QStringList out;
+		quint32 seed = 42;
+		auto next = [&seed](const quint32 max)
+		{
+			seed = seed * 1103515245 + 12345;
+			return (seed >> 16) % max;
+		};
+		for (int i = 0; i < count; ++i)
+		{
+			QString version = QString("%1.%2.%3.%4")
+								  .arg(next(15))
+								  .arg(next(20))
+								  .arg(next(5))
+								  .arg(next(1500));
+			// a few have a branch name tacked on
+			if (next(20) == 0)
+			{
+				version += ".new";
+			}
+			out.append(version);
+		}
+		return out;
 	}
 
 private slots:
@@ -145,6 +245,70 @@ private slots:
 		const auto v2 = Util::Version(second);
 
 		QCOMPARE(v1 == v2, equal);
+		QCOMPARE(v1 != v2, !equal);
+		QCOMPARE(v1 <= v2, lessThan || equal);
+		QCOMPARE(v1 >= v2, !lessThan);
+	}
+
+	void test_sortMatchesBaseline()
+	{
+		const QStringList versions = forgeVersions(10000);
+		QStringList expected = versions;
+		std::stable_sort(expected.begin(), expected.end(), [](const QString &a, const QString &b)
+		{ return Baseline::Version(a) < Baseline::Version(b); });
+		QStringList sorted = versions;
+		std::stable_sort(sorted.begin(), sorted.end(), [](const QString &a, const QString &b)
+		{ return Util::Version(a) < Util::Version(b); });
+		QCOMPARE(sorted, expected);
+	}
+
+	// sorting 10k forge versions, parsing the strings on every comparison
+	void bench_sortForgeStrings_baseline()
+	{
+		const QStringList versions = forgeVersions(10000);
+		QBENCHMARK
+		{
+			QStringList sorted = versions;
+			std::sort(sorted.begin(), sorted.end(), [](const QString &a, const QString &b)
+			{ return Baseline::Version(a) < Baseline::Version(b); });
+		}
+	}
+	void bench_sortForgeStrings()
+	{
+		const QStringList versions = forgeVersions(10000);
+		QBENCHMARK
+		{
+			QStringList sorted = versions;
+			std::sort(sorted.begin(), sorted.end(), [](const QString &a, const QString &b)
+			{ return Util::Version(a) < Util::Version(b); });
+		}
+	}
+	// and with versions parsed up front, which is what the comparisons are made for
+	void bench_sortForgeVersions_baseline()
+	{
+		QList<Baseline::Version> versions;
+		for (auto version : forgeVersions(10000))
+		{
+			versions.append(Baseline::Version(version));
+		}
+		QBENCHMARK
+		{
+			QList<Baseline::Version> sorted = versions;
+			std::sort(sorted.begin(), sorted.end());
+		}
+	}
+	void bench_sortForgeVersions()
+	{
+		QList<Util::Version> versions;
+		for (auto version : forgeVersions(10000))
+		{
+			versions.append(Util::Version(version));
+		}
+		QBENCHMARK
+		{
+			QList<Util::Version> sorted = versions;
+			std::sort(sorted.begin(), sorted.end());
+		}
 	}
 };
 
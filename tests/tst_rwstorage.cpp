@@ -0,0 +1,204 @@
+#include <QTest>
+#include <QtConcurrentRun>
+#include <QFuture>
+#include <QThread>
+#include "TestUtil.h"
+
+#include "logic/RWStorage.h"
+
+class RWStorageTest : public QObject
+{
+	Q_OBJECT
+
+	// every reader looks up all the keys this many times
+	static const int ROUNDS = 200;
+	static const int KEYS = 1000;
+
+	static QString key(int i)
+	{
+		return QString("screenshots/%1.png").arg(i);
+	}
+
+	// returns the number of lookups that found the wrong value
+	static int readAll(RWStorage<QString, int> *storage)
+	{
+		int wrong = 0;
+		for (int round = 0; round < ROUNDS; round++)
+		{
+			for (int i = 0; i < KEYS; i++)
+			{
+				int value = -1;
+				if (storage->get(key(i), value) && value != i)
+					wrong++;
+			}
+		}
+		return wrong;
+	}
+	static void writeAll(RWStorage<QString, int> *storage)
+	{
+		for (int round = 0; round < ROUNDS / 10; round++)
+		{
+			for (int i = 0; i < KEYS; i++)
+			{
+				storage->setStale(key(i));
+				storage->add(key(i), i);
+			}
+		}
+	}
+
+private
+slots:
+	void test_addGet()
+	{
+		RWStorage<QString, int> storage;
+		QVERIFY(!storage.has("a"));
+		QVERIFY(storage.stale("a"));
+		QCOMPARE(storage.get("a"), 0);
+
+		storage.add("a", 1);
+		storage.add("b", 2);
+		QVERIFY(storage.has("a"));
+		QVERIFY(!storage.stale("a"));
+		QCOMPARE(storage.get("a"), 1);
+		int value = 0;
+		QVERIFY(storage.get("b", value));
+		QCOMPARE(value, 2);
+
+		storage.add("a", 3);
+		QCOMPARE(storage.get("a"), 3);
+		QCOMPARE(storage.stats().entries, 2);
+
+		QVERIFY(storage.remove("a"));
+		QVERIFY(!storage.remove("a"));
+		QVERIFY(!storage.has("a"));
+
+		storage.clear();
+		QCOMPARE(storage.stats().entries, 0);
+	}
+
+	void test_stale()
+	{
+		RWStorage<QString, int> storage;
+		storage.setStale("a");
+		QVERIFY(storage.stale("a"));
+		QVERIFY(!storage.has("a"));
+
+		storage.add("a", 1);
+		storage.setStale("a");
+		QVERIFY(storage.stale("a"));
+		// still readable until it's replaced
+		QCOMPARE(storage.get("a"), 1);
+		storage.add("a", 2);
+		QVERIFY(!storage.stale("a"));
+	}
+
+	void test_counters()
+	{
+		RWStorage<QString, int> storage;
+		storage.add("a", 1);
+		storage.get("a");
+		storage.get("a");
+		storage.get("b");
+		auto stats = storage.stats();
+		QCOMPARE(stats.hits, quint64(2));
+		QCOMPARE(stats.misses, quint64(1));
+	}
+
+	void test_entryLimit()
+	{
+		RWStorage<QString, int> storage(160);
+		for (int i = 0; i < KEYS; i++)
+		{
+			storage.add(key(i), i);
+		}
+		auto stats = storage.stats();
+		// the limit is split between the shards, so it's only roughly kept
+		QVERIFY(stats.entries <= 160);
+		QVERIFY(stats.entries > 80);
+		QCOMPARE(stats.evictions, quint64(KEYS - stats.entries));
+		// the newest entries are the ones left
+		QVERIFY(storage.has(key(KEYS - 1)));
+		QVERIFY(!storage.has(key(0)));
+	}
+
+	void test_lru()
+	{
+		RWStorage<QString, int> storage(16);
+		// with 16 shards, the limit of each is one entry. Find two keys in the same shard.
+		const QString first = key(0);
+		QString second;
+		for (int i = 1; second.isEmpty(); i++)
+		{
+			if (qHash(key(i)) % 16 == qHash(first) % 16)
+				second = key(i);
+		}
+		storage.add(first, 1);
+		QVERIFY(storage.has(first));
+		storage.add(second, 2);
+		QVERIFY(!storage.has(first));
+		QVERIFY(storage.has(second));
+	}
+
+	void test_costLimit()
+	{
+		RWStorage<QString, int> storage(0, 16 * 1000);
+		for (int i = 0; i < KEYS; i++)
+		{
+			storage.add(key(i), i, 100);
+		}
+		auto stats = storage.stats();
+		QVERIFY(stats.cost <= 16 * 1000);
+		QCOMPARE(stats.cost, qint64(stats.entries) * 100);
+
+		// something too expensive alone still goes in, and pushes out the rest of its shard
+		storage.add("huge", 0, 1000000);
+		QVERIFY(storage.has("huge"));
+	}
+
+	void test_concurrentReaders()
+	{
+		RWStorage<QString, int> storage;
+		for (int i = 0; i < KEYS; i++)
+		{
+			storage.add(key(i), i);
+		}
+		QList<QFuture<int>> readers;
+		for (int i = 0; i < 8; i++)
+		{
+			readers.append(QtConcurrent::run(&RWStorageTest::readAll, &storage));
+		}
+		QFuture<void> writer = QtConcurrent::run(&RWStorageTest::writeAll, &storage);
+		for (auto &reader : readers)
+		{
+			QCOMPARE(reader.result(), 0);
+		}
+		writer.waitForFinished();
+		QCOMPARE(storage.stats().entries, KEYS);
+	}
+
+	void bench_concurrentReaders()
+	{
+		RWStorage<QString, int> storage(KEYS / 2);
+		for (int i = 0; i < KEYS; i++)
+		{
+			storage.add(key(i), i);
+		}
+		const int threads = qMax(2, QThread::idealThreadCount());
+		QBENCHMARK
+		{
+			QList<QFuture<int>> readers;
+			for (int i = 0; i < threads; i++)
+			{
+				readers.append(QtConcurrent::run(&RWStorageTest::readAll, &storage));
+			}
+			for (auto &reader : readers)
+			{
+				reader.waitForFinished();
+			}
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN_MULTIMC(RWStorageTest)
+
+#include "tst_rwstorage.moc"
@@ -0,0 +1,74 @@
+#include <QTest>
+#include <QTemporaryDir>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include "TestUtil.h"
+
+#include "logic/screenshots/ThumbnailCache.h"
+
+class ThumbnailCacheTest : public QObject
+{
+	Q_OBJECT
+
+	QImage image(const QColor &color, int size)
+	{
+		QImage result(size, size, QImage::Format_ARGB32);
+		result.fill(color);
+		return result;
+	}
+
+private
+slots:
+	void test_layout()
+	{
+		ThumbnailCache cache("thumbnails");
+		const QString normal = cache.thumbnailPath("/tmp/screenshot.png", 128);
+		const QString large = cache.thumbnailPath("/tmp/screenshot.png", 256);
+		QCOMPARE(QFileInfo(normal).dir().dirName(), QString("normal"));
+		QCOMPARE(QFileInfo(large).dir().dirName(), QString("large"));
+		// MD5 of file:///tmp/screenshot.png
+		QCOMPARE(QFileInfo(large).fileName(), QString("%1.png").arg(QString::fromLatin1(
+			QCryptographicHash::hash("file:///tmp/screenshot.png", QCryptographicHash::Md5)
+				.toHex())));
+	}
+
+	void test_storeAndLoad()
+	{
+		QTemporaryDir dir;
+		QVERIFY(dir.isValid());
+		const QString source = dir.path() + "/screenshot.png";
+		QVERIFY(image(Qt::red, 512).save(source));
+
+		ThumbnailCache cache(dir.path() + "/thumbnails");
+		QVERIFY(cache.load(source, 256).isNull());
+		QVERIFY(cache.store(source, 256, image(Qt::blue, 256)));
+
+		const QImage loaded = cache.load(source, 256);
+		QCOMPARE(loaded.size(), QSize(256, 256));
+		QCOMPARE(loaded.pixel(10, 10), QColor(Qt::blue).rgb());
+		// other sizes have their own thumbnails
+		QVERIFY(cache.load(source, 128).isNull());
+	}
+
+	void test_outdated()
+	{
+		QTemporaryDir dir;
+		QVERIFY(dir.isValid());
+		const QString source = dir.path() + "/screenshot.png";
+		QVERIFY(image(Qt::red, 64).save(source));
+
+		ThumbnailCache cache(dir.path() + "/thumbnails");
+		QVERIFY(cache.store(source, 256, image(Qt::blue, 64)));
+		QVERIFY(!cache.load(source, 256).isNull());
+
+		// the modification time is stored in seconds
+		QTest::qWait(1100);
+		QVERIFY(image(Qt::green, 64).save(source));
+		QVERIFY(cache.load(source, 256).isNull());
+	}
+};
+
+QTEST_GUILESS_MAIN_MULTIMC(ThumbnailCacheTest)
+
+#include "tst_thumbnailcache.moc"